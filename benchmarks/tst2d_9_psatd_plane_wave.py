@@ -0,0 +1,67 @@
+# ----------------------------------------------------------------------------------------
+# 					SIMULATION PARAMETERS FOR THE PIC-CODE SMILEI
+# ----------------------------------------------------------------------------------------
+#
+# Plane wave in a periodic box with the spectral solver (requires Smilei compiled with
+# make config=fftw), at twice the CFL timestep of the Yee solver. The fields of each patch
+# are transformed as if they were periodic : the validation compares Ez to the exact plane
+# wave at the borders of the patches and elsewhere.
+
+import math
+
+l0 = 2.0*math.pi        # laser wavelength
+t0 = l0                 # optical cycle
+Lsim = [8.*l0,8.*l0]    # length of the simulation
+Tsim = 10.*t0           # duration of the simulation
+resx = 16.              # nb of cells in one laser wavelength
+
+Main(
+    geometry = "2d3v",
+
+    interpolation_order = 2 ,
+
+    cell_length = [l0/resx,l0/resx],
+    sim_length  = Lsim,
+
+    number_of_patches = [ 8, 4 ],
+
+    timestep_over_CFL = 2.,
+    sim_time = Tsim,
+
+    maxwell_sol = "PSATD",
+    psatd_order = 8,
+    psatd_guard_cells = 8,
+
+    bc_em_type_x = ['periodic'],
+    bc_em_type_y = ['periodic'],
+
+    random_seed = smilei_mpi_rank
+)
+
+# Wave vector : 5 and 3 periods along x and y. Polarization along z
+kx = 2.*math.pi*5./Lsim[0]
+ky = 2.*math.pi*3./Lsim[1]
+k  = math.sqrt(kx**2+ky**2)
+# The magnetic field is defined half a timestep later than the electric field
+dt = Main.timestep
+
+ExtField(
+    field = "Ez",
+    profile = lambda x,y: math.cos(kx*x+ky*y)
+)
+ExtField(
+    field = "Bx",
+    profile = lambda x,y: ky/k*math.cos(kx*x+ky*y-0.5*k*dt)
+)
+ExtField(
+    field = "By",
+    profile = lambda x,y: -kx/k*math.cos(kx*x+ky*y-0.5*k*dt)
+)
+
+
+DiagScalar(every=10)
+
+DiagFields(
+    every = 10,
+    fields = ['Ez']
+)
@@ -100,6 +100,10 @@ public:
             // Check whether electrons are tracked
             if( Z0==0 )      tracked_electrons = vecSpecies[sgroup[0][0]]->particles->tracked;
             else if( Z1==0 ) tracked_electrons = vecSpecies[sgroup[1][0]]->particles->tracked;
+            // New electrons are copies of existing ones, which must not store relative positions
+            if( ( Z0==0 && vecSpecies[sgroup[0][0]]->particles->relative_positions )
+             || ( Z1==0 && vecSpecies[sgroup[1][0]]->particles->relative_positions ) )
+                ERROR("In collisions #" << n_collisions << ": ionization is not available for electrons with relative_positions");
         }
         
         // Print collisions parameters
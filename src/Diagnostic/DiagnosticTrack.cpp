@@ -8,6 +8,12 @@
 
 #ifdef SMILEI_USE_NUMPY
 #include <numpy/arrayobject.h>
+// numpy type of the particle momentum
+#ifdef __MIXED_PRECISION
+#define NPY_PARTICLE_REAL NPY_FLOAT
+#else
+#define NPY_PARTICLE_REAL NPY_DOUBLE
+#endif
 #endif
 
 
@@ -182,9 +188,9 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
                 Particles * p = vecPatches(ipatch)->vecSpecies[speciesId_]->particles;
                 unsigned int npart = p->size();
                 dims[0] = (npy_intp) npart;
-                px = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (double*)(p->Momentum[0].data()));
-                py = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (double*)(p->Momentum[1].data()));
-                pz = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (double*)(p->Momentum[2].data()));
+                px = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_PARTICLE_REAL, (particle_real*)(p->Momentum[0].data()));
+                py = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_PARTICLE_REAL, (particle_real*)(p->Momentum[1].data()));
+                pz = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_PARTICLE_REAL, (particle_real*)(p->Momentum[2].data()));
                 x  = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (double*)(p->Position[0].data()));
                 if( nDim_particle>1 ) {
                     y = (PyArrayObject*)PyArray_SimpleNewFromData(1, dims, NPY_DOUBLE, (double*)(p->Position[1].data()));
@@ -307,11 +313,18 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
         H5Sclose( memspace );
     }
     
+    // Index of the momentum and weight in the list of properties of their type
+#ifdef __MIXED_PRECISION
+    unsigned int first_real_prop = 0;
+#else
+    unsigned int first_real_prop = nDim_particle;
+#endif
+    
     // Id
     #pragma omp master
     data_uint64.resize( nParticles_local, 1 );
     #pragma omp barrier
-    fill_buffer(vecPatches, 0, data_uint64);
+    fill_buffer<uint64_t>(vecPatches, 0, data_uint64);
     #pragma omp master
     {
         write_scalar( species_group, "id", data_uint64[0], H5T_NATIVE_UINT64, file_space, mem_space, plist, SMILEI_UNIT_NONE, nParticles_global );
@@ -322,7 +335,7 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     #pragma omp master
     data_short.resize( nParticles_local, 0 );
     #pragma omp barrier
-    fill_buffer(vecPatches, 0, data_short);
+    fill_buffer<short>(vecPatches, 0, data_short);
     #pragma omp master
     {
         write_scalar( species_group, "charge", data_short[0], H5T_NATIVE_SHORT, file_space, mem_space, plist, SMILEI_UNIT_CHARGE, nParticles_global );
@@ -333,7 +346,7 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     #pragma omp master
     data_double.resize( nParticles_local, 0 );
     #pragma omp barrier
-    fill_buffer(vecPatches, nDim_particle+3, data_double);
+    fill_buffer<particle_real>(vecPatches, first_real_prop+3, data_double);
     #pragma omp master
     write_scalar( species_group, "weight", data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_DENSITY, nParticles_global );
     
@@ -345,7 +358,7 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     }
     for( unsigned int idim=0; idim<3; idim++ ) {
         #pragma omp barrier
-        fill_buffer(vecPatches, nDim_particle+idim, data_double);
+        fill_buffer<particle_real>(vecPatches, first_real_prop+idim, data_double);
         #pragma omp master
         write_component( momentum_group, xyz.substr(idim,1).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_MOMENTUM, nParticles_global );
     }
@@ -360,7 +373,7 @@ void DiagnosticTrack::run( SmileiMPI* smpi, VectorPatch& vecPatches, int itime,
     }
     for( unsigned int idim=0; idim<nDim_particle; idim++ ) {
         #pragma omp barrier
-        fill_buffer(vecPatches, idim, data_double);
+        fill_buffer<double>(vecPatches, idim, data_double);
         #pragma omp master
         write_component( position_group, xyz.substr(idim,1).c_str(), data_double[0], H5T_NATIVE_DOUBLE, file_space, mem_space, plist, SMILEI_UNIT_POSITION, nParticles_global );
     }
@@ -425,11 +438,11 @@ void DiagnosticTrack::setIDs(Particles& particles)
 }
 
 
-template<typename T>
+template<typename U, typename T>
 void DiagnosticTrack::fill_buffer(VectorPatch& vecPatches, unsigned int iprop, vector<T>& buffer)
 {
     unsigned int patch_nParticles, i, j, nPatches=vecPatches.size();
-    vector<T>* property = NULL;
+    aligned_vector<U>* property = NULL;
     
     if( has_filter ) {
         #pragma omp for schedule(runtime)
@@ -31,8 +31,8 @@ public :
         return 0;
     }
     
-    //! Fills a buffer with the required particle property
-    template<typename T> void fill_buffer(VectorPatch& vecPatches, unsigned int iprop, std::vector<T>& buffer);
+    //! Fills a buffer with the required particle property (of type U, converted to the buffer type T)
+    template<typename U, typename T> void fill_buffer(VectorPatch& vecPatches, unsigned int iprop, std::vector<T>& buffer);
     
     //! Write a scalar dataset with the given buffer
     template<typename T> void write_scalar( hid_t, std::string, T&, hid_t, hid_t, hid_t, hid_t, unsigned int, unsigned int );
@@ -13,6 +13,7 @@
 #include "Patch.h"
 #include "Profile.h"
 #include "SolverFactory.h"
+#include "FieldArena.h"
 
 using namespace std;
 
@@ -46,6 +47,9 @@ nrj_new_fields (  0.               )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA(params);
     MaxwellFaradaySolver_ = SolverFactory::createMF(params);
+    MaxwellSolver_        = SolverFactory::createMAF(params);
+    vacuum_               = params.skip_vacuum_patches;
+    vacuum_checked_       = false;
     
 }
 
@@ -72,6 +76,9 @@ nrj_new_fields ( 0. )
     
     MaxwellAmpereSolver_  = SolverFactory::createMA(params);
     MaxwellFaradaySolver_ = SolverFactory::createMF(params);
+    MaxwellSolver_        = SolverFactory::createMAF(params);
+    vacuum_               = params.skip_vacuum_patches;
+    vacuum_checked_       = false;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -100,6 +107,7 @@ void ElectroMagn::initElectroMagnQuantities()
     Jy_=NULL;
     Jz_=NULL;
     rho_=NULL;
+    arena_=NULL;
     
     
     // Species charge currents and density
@@ -120,6 +128,10 @@ void ElectroMagn::initElectroMagnQuantities()
             bufsize[i][j]=0;
         }
     }
+    
+#ifdef _OPENMP
+    omp_init_lock( &currents_lock );
+#endif
 }
 
 
@@ -150,11 +162,111 @@ void ElectroMagn::finishInitialization(int nspecies, Patch* patch)
     
 }
 
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Main fields of the patch in a single block : E, B and B_m first (moved together by the load balancing), then the
+// currents, the density and the fields of the Friedman filter. The species fields, allocated only when a diagnostic
+// needs them, keep their own arrays
+// ---------------------------------------------------------------------------------------------------------------------
+void ElectroMagn::gatherFields()
+{
+    vector<Field*> fields;
+    fields.push_back(Ex_ );
+    fields.push_back(Ey_ );
+    fields.push_back(Ez_ );
+    fields.push_back(Bx_ );
+    fields.push_back(By_ );
+    fields.push_back(Bz_ );
+    fields.push_back(Bx_m);
+    fields.push_back(By_m);
+    fields.push_back(Bz_m);
+    fields.push_back(Jx_ );
+    fields.push_back(Jy_ );
+    fields.push_back(Jz_ );
+    fields.push_back(rho_);
+    
+    vector<Field*>* filters[6] = { &Exfilter, &Eyfilter, &Ezfilter, &Bxfilter, &Byfilter, &Bzfilter };
+    for (unsigned int ifilter=0; ifilter<6; ifilter++)
+        for (unsigned int i=0; i<filters[ifilter]->size(); i++)
+            fields.push_back( (*filters[ifilter])[i] );
+    
+    arena_ = new FieldArena( fields );
+    
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// True if the values of field are zero within width cells of the edges of its arrays
+// ---------------------------------------------------------------------------------------------------------------------
+static bool isZeroNearEdges( Field* field, unsigned int width )
+{
+    unsigned int n[3] = { 1, 1, 1 };
+    for (unsigned int iDim=0; iDim<field->dims_.size(); iDim++)
+        n[iDim] = field->dims_[iDim];
+    
+    for (unsigned int iDim=0; iDim<field->dims_.size(); iDim++) {
+        for (unsigned int side=0; side<2; side++) {
+            unsigned int start[3] = { 0, 0, 0 };
+            unsigned int end[3]   = { n[0], n[1], n[2] };
+            if ( width < n[iDim] ) {
+                if ( side==0 ) end[iDim]   = width;
+                else           start[iDim] = n[iDim]-width;
+            }
+            for (unsigned int i=start[0]; i<end[0]; i++)
+                for (unsigned int j=start[1]; j<end[1]; j++)
+                    for (unsigned int k=start[2]; k<end[2]; k++)
+                        if ( field->data_[(i*n[1]+j)*n[2]+k] != 0. ) return false;
+        }
+    }
+    return true;
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Stops at the first non-zero value : the patches reached by the fields are not checked for long
+// All the points are checked once. Then, while the solver is skipped, only the cells which may have been changed
+// from outside the patch are checked :
+//   - E and B near the edges : ghost cells exchanged, boundary conditions and lasers
+//   - J near the edges, where the currents of the neighbours are summed, or everywhere with antennas
+// ---------------------------------------------------------------------------------------------------------------------
+bool ElectroMagn::isVacuum()
+{
+    Field* fields[12] = { Ex_, Ey_, Ez_, Bx_, By_, Bz_, Bx_m, By_m, Bz_m, Jx_, Jy_, Jz_ };
+    if ( !vacuum_checked_ ) {
+        for (unsigned int ifield=0; ifield<12; ifield++) {
+            double* data = fields[ifield]->data_;
+            for (unsigned int i=0; i<fields[ifield]->globalDims_; i++)
+                if ( data[i] != 0. ) return false;
+        }
+        vacuum_checked_ = true;
+        return true;
+    }
+    
+    unsigned int width = 0;
+    for (unsigned int iDim=0; iDim<oversize.size(); iDim++)
+        width = max( width, oversize[iDim] );
+    for (unsigned int ifield=0; ifield<9; ifield++)
+        if ( !isZeroNearEdges( fields[ifield], width+1 ) ) return false;
+    for (unsigned int ifield=9; ifield<12; ifield++) {
+        if ( antennas.size() > 0 ) {
+            double* data = fields[ifield]->data_;
+            for (unsigned int i=0; i<fields[ifield]->globalDims_; i++)
+                if ( data[i] != 0. ) return false;
+        }
+        else if ( !isZeroNearEdges( fields[ifield], 2*width+2 ) )
+            return false;
+    }
+    return true;
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Destructor for the virtual class ElectroMagn
 // ---------------------------------------------------------------------------------------------------------------------
 ElectroMagn::~ElectroMagn()
 {
+#ifdef _OPENMP
+    omp_destroy_lock( &currents_lock );
+#endif
+    
     delete Ex_;
     delete Ey_;
     delete Ez_;
@@ -199,6 +311,10 @@ ElectroMagn::~ElectroMagn()
     
     delete MaxwellAmpereSolver_;
     delete MaxwellFaradaySolver_;
+    if (MaxwellSolver_) delete MaxwellSolver_;
+    
+    // After the fields, which do not free their data
+    if (arena_) delete arena_;
     
     //antenna cleanup
     for (vector<Antenna>::iterator antenna=antennas.begin(); antenna!=antennas.end(); antenna++ ) {
@@ -5,6 +5,10 @@
 #include <string>
 #include <map>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 #include "Field.h"
 #include "Tools.h"
 #include "Profile.h"
@@ -18,6 +22,7 @@ class ElectroMagnBC;
 class SimWindow;
 class Patch;
 class Solver;
+class FieldArena;
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -54,6 +59,8 @@ public:
     void initElectroMagnQuantities();
     //! Extra initialization. Used in ElectroMagnFactory
     void finishInitialization(int nspecies, Patch* patch);
+    //! Move the main fields to a single block (Main.field_arena). Used in ElectroMagnFactory
+    void gatherFields();
     
     //! Destructor for Electromagn
     virtual ~ElectroMagn();
@@ -61,6 +68,19 @@ public:
     void updateGridSize(Params &params, Patch* patch);
 
     void clean();
+    
+    //! Lock the currents of the patch, when several threads add their contributions to them (see Species::dynamicsTiled)
+    inline void lockCurrents() {
+#ifdef _OPENMP
+        omp_set_lock( &currents_lock );
+#endif
+    }
+    //! Unlock the currents of the patch
+    inline void unlockCurrents() {
+#ifdef _OPENMP
+        omp_unset_lock( &currents_lock );
+#endif
+    }
         
     std::vector<unsigned int> dimPrim;
     std::vector<unsigned int> dimDual;
@@ -129,6 +149,9 @@ public:
     //! all Fields in electromagn (filled in ElectromagnFactory.h)
     std::vector<Field*> allFields;
     
+    //! Block containing Ex_ ... Bz_m (first 9 fields), Jx_ ... rho_ and the filters, NULL if not used (see gatherFields)
+    FieldArena* arena_;
+    
     //! all Fields averages required in diagnostic Fields
     std::vector<std::vector<Field*> > allFields_avg;
     
@@ -214,6 +237,14 @@ public:
     Solver* MaxwellAmpereSolver_;
     //! Maxwell Faraday Solver
     Solver* MaxwellFaradaySolver_;
+    //! Fused Maxwell solver : save of B, Maxwell Ampere and Maxwell Faraday in one pass (NULL if not available)
+    Solver* MaxwellSolver_;
+    //! true while the fields of the patch may all be zero (Main.skip_vacuum_patches), checked by isVacuum
+    bool vacuum_;
+    //! true once isVacuum found all the points zero : then it only checks the cells changed from outside the patch
+    bool vacuum_checked_;
+    //! true if E, B, B_m and J are zero on all points, ghost cells included : the Maxwell solver keeps them zero
+    bool isVacuum();
     virtual void saveMagneticFields() = 0;
     virtual void centerMagneticFields() = 0;
     virtual void binomialCurrentFilter() = 0;
@@ -323,6 +354,11 @@ private:
     //! Accumulate nrj added with new fields
     double nrj_new_fields;
     
+#ifdef _OPENMP
+    //! Lock protecting the currents when bins of the patch are processed by several threads
+    omp_lock_t currents_lock;
+#endif
+    
 };
 
 #endif
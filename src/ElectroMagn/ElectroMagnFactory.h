@@ -104,6 +104,8 @@ public:
         
         
         EMfields->finishInitialization(vecSpecies.size(), patch);
+        if ( params.field_arena )
+            EMfields->gatherFields();
         
         return EMfields;
     }
@@ -178,6 +180,8 @@ public:
         
         
         newEMfields->finishInitialization(vecSpecies.size(), patch);
+        if ( params.field_arena )
+            newEMfields->gatherFields();
         
         return newEMfields;
     }
@@ -20,6 +20,8 @@ min_max(_min_max)
     
     // time step
     dt = params.timestep;
+    
+    ghost_shift = params.temporal_blocking - 1;
 }
 
 // Destructor for ElectromagnBC
@@ -35,6 +35,10 @@ protected:
 
     // side of BC is applied 0:xmin 1:xmax 2:ymin 3:ymax 4:zmin 5:zmax
     unsigned int min_max;
+    
+    //! Number of ghost cells beyond the boundary, not used (added by temporal_blocking) : the boundary conditions are
+    //! applied ghost_shift cells inside the arrays, so that the boundary stays at the same place
+    unsigned int ghost_shift;
 
 };
 
@@ -47,17 +47,17 @@ void ElectroMagnBC1D_SM::save_fields(Field* my_field, Patch *patch) {
     
     if (min_max == 0 && patch->isXmin() ) {
         if (field1D->name=="By"){
-            By_val = (*my_field)(0);
+            By_val = (*my_field)(ghost_shift);
         }
         else if (field1D->name=="Bz"){
-            Bz_val = (*my_field)(0);
+            Bz_val = (*my_field)(ghost_shift);
         }
     } else if (min_max == 1 && patch->isXmax() ) {
         if (field1D->name=="By"){
-            By_val = (*my_field)(field1D->dims()[0]-1);
+            By_val = (*my_field)(field1D->dims()[0]-1-ghost_shift);
         }
         else if (field1D->name=="Bz"){
-            Bz_val = (*my_field)(field1D->dims()[0]-1);
+            Bz_val = (*my_field)(field1D->dims()[0]-1-ghost_shift);
         }
         
     }
@@ -88,8 +88,8 @@ void ElectroMagnBC1D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         }
         
         // Apply Silver-Mueller EM boundary condition at x=xmin
-        (*By1D)(0) =  Alpha_SM*(*Ez1D)(0) + Beta_SM*((*By1D)(1)-By_val) + Gamma_SM*byL+By_val;
-        (*Bz1D)(0) = -Alpha_SM*(*Ey1D)(0) + Beta_SM*((*Bz1D)(1)-Bz_val) + Gamma_SM*bzL+Bz_val;
+        (*By1D)(ghost_shift) =  Alpha_SM*(*Ez1D)(ghost_shift) + Beta_SM*((*By1D)(ghost_shift+1)-By_val) + Gamma_SM*byL+By_val;
+        (*Bz1D)(ghost_shift) = -Alpha_SM*(*Ey1D)(ghost_shift) + Beta_SM*((*Bz1D)(ghost_shift+1)-Bz_val) + Gamma_SM*bzL+Bz_val;
         
     } else if (min_max == 1 && patch->isXmax() ) {
         //Field1D* Ex1D   = static_cast<Field1D*>(EMfields->Ex_);
@@ -108,8 +108,8 @@ void ElectroMagnBC1D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         }
         
         // Silver-Mueller boundary conditions (right)
-        (*By1D)(nx_d-1) = -Alpha_SM*(*Ez1D)(nx_p-1)+ Beta_SM*((*By1D)(nx_d-2)-By_val) + Gamma_SM*byR+By_val;
-        (*Bz1D)(nx_d-1) =  Alpha_SM*(*Ey1D)(nx_p-1)+ Beta_SM*((*Bz1D)(nx_d-2)-Bz_val) + Gamma_SM*bzR+Bz_val;
+        (*By1D)(nx_d-1-ghost_shift) = -Alpha_SM*(*Ez1D)(nx_p-1-ghost_shift)+ Beta_SM*((*By1D)(nx_d-2-ghost_shift)-By_val) + Gamma_SM*byR+By_val;
+        (*Bz1D)(nx_d-1-ghost_shift) =  Alpha_SM*(*Ey1D)(nx_p-1-ghost_shift)+ Beta_SM*((*Bz1D)(nx_d-2-ghost_shift)-Bz_val) + Gamma_SM*bzR+Bz_val;
     }
     
 }
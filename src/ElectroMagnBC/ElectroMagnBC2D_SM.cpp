@@ -115,76 +115,76 @@ void ElectroMagnBC2D_SM::save_fields(Field* my_field, Patch* patch) {
     if (min_max == 0 && patch->isXmin() ) {
         if (field2D->name=="Bx"){
             for (unsigned int j=0; j<ny_d; j++) {
-                Bx_val[j]=(*field2D)(0,j);
+                Bx_val[j]=(*field2D)(ghost_shift,j);
             }
         }
         
         if (field2D->name=="By"){
             for (unsigned int j=0; j<ny_p; j++) {
-                By_val[j]=(*field2D)(0,j);
+                By_val[j]=(*field2D)(ghost_shift,j);
             }
         }
         
         if (field2D->name=="Bz"){
             for (unsigned int j=0; j<ny_d; j++) {
-                Bz_val[j]=(*field2D)(0,j);
+                Bz_val[j]=(*field2D)(ghost_shift,j);
             }
         }
     }
     else if (min_max == 1 && patch->isXmax() ) {
         if (field2D->name=="Bx"){
             for (unsigned int j=0; j<ny_d; j++) {
-                Bx_val[j]=(*field2D)(nx_p-1,j);
+                Bx_val[j]=(*field2D)(nx_p-1-ghost_shift,j);
             }
         }
         
         if (field2D->name=="By"){
             for (unsigned int j=0; j<ny_p; j++) {
-                By_val[j]=(*field2D)(nx_d-1,j);
+                By_val[j]=(*field2D)(nx_d-1-ghost_shift,j);
             }
         }
         
         if (field2D->name=="Bz"){
             for (unsigned int j=0; j<ny_d; j++) {
-                Bz_val[j]=(*field2D)(nx_d-1,j);
+                Bz_val[j]=(*field2D)(nx_d-1-ghost_shift,j);
             }
         }
     }
     else if (min_max == 2 && patch->isYmin() ) {
         if (field2D->name=="Bx"){
             for (unsigned int i=0; i<nx_p; i++) {
-                Bx_val[i]=(*field2D)(i,0);
+                Bx_val[i]=(*field2D)(i,ghost_shift);
             }
         }
         
         if (field2D->name=="By"){
             for (unsigned int i=0; i<nx_d; i++) {
-                By_val[i]=(*field2D)(i,0);
+                By_val[i]=(*field2D)(i,ghost_shift);
             }
         }
         
         if (field2D->name=="Bz"){
             for (unsigned int i=0; i<nx_d; i++) {
-                Bz_val[i]=(*field2D)(i,0);
+                Bz_val[i]=(*field2D)(i,ghost_shift);
             }
         }
     }
     else if (min_max == 3 && patch->isYmax() ) {
         if (field2D->name=="Bx"){
             for (unsigned int i=0; i<nx_p; i++) {
-                Bx_val[i]=(*field2D)(i,ny_d-1);
+                Bx_val[i]=(*field2D)(i,ny_d-1-ghost_shift);
             }
         }
         
         if (field2D->name=="By"){
             for (unsigned int i=0; i<nx_d; i++) {
-                By_val[i]=(*field2D)(i,ny_p-1);
+                By_val[i]=(*field2D)(i,ny_p-1-ghost_shift);
             }
         }
         
         if (field2D->name=="Bz"){
             for (unsigned int i=0; i<nx_d; i++) {
-                Bz_val[i]=(*field2D)(i,ny_d-1);
+                Bz_val[i]=(*field2D)(i,ny_d-1-ghost_shift);
             }
         }
     }
@@ -227,11 +227,11 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
                 byW += vecLaser[ilaser]->getAmplitude0(yp, time_dual, j, 0);
             }
             
-            (*By2D)(0,j) = Alpha_SM_W   * (*Ez2D)(0,j)
-            +              Beta_SM_W    *( (*By2D)(1,j)-By_val[j])
+            (*By2D)(ghost_shift,j) = Alpha_SM_W   * (*Ez2D)(ghost_shift,j)
+            +              Beta_SM_W    *( (*By2D)(ghost_shift+1,j)-By_val[j])
             +              Gamma_SM_W   * byW
-            +              Delta_SM_W   *( (*Bx2D)(0,j+1)-Bx_val[j+1] )
-            +              Epsilon_SM_W *( (*Bx2D)(0,j)-Bx_val[j] )
+            +              Delta_SM_W   *( (*Bx2D)(ghost_shift,j+1)-Bx_val[j+1] )
+            +              Epsilon_SM_W *( (*Bx2D)(ghost_shift,j)-Bx_val[j] )
             +              By_val[j];
             
         }//j  ---end compute By
@@ -253,8 +253,8 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
             /*(*Bz2D)(0,j) = -Alpha_SM_W * (*Ey2D)(0,j)
              +               Beta_SM_W  * (*Bz2D)(1,j)
              +               Gamma_SM_W * bzW;*/
-            (*Bz2D)(0,j) = -Alpha_SM_W * (*Ey2D)(0,j)
-            +               Beta_SM_W  *( (*Bz2D)(1,j)- Bz_val[j])
+            (*Bz2D)(ghost_shift,j) = -Alpha_SM_W * (*Ey2D)(ghost_shift,j)
+            +               Beta_SM_W  *( (*Bz2D)(ghost_shift+1,j)- Bz_val[j])
             +               Gamma_SM_W * bzW
             +               Bz_val[j];
             
@@ -289,11 +289,11 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
              +                   Gamma_SM_E   * byE
              +                   Delta_SM_E   * (*Bx2D)(nx_p-1,j+1) // Check x-index
              +                   Epsilon_SM_E * (*Bx2D)(nx_p-1,j);*/
-            (*By2D)(nx_d-1,j) = Alpha_SM_E   * (*Ez2D)(nx_p-1,j)
-            +                   Beta_SM_E    *( (*By2D)(nx_d-2,j) -By_val[j])
+            (*By2D)(nx_d-1-ghost_shift,j) = Alpha_SM_E   * (*Ez2D)(nx_p-1-ghost_shift,j)
+            +                   Beta_SM_E    *( (*By2D)(nx_d-2-ghost_shift,j) -By_val[j])
             +                   Gamma_SM_E   * byE
-            +                   Delta_SM_E   *( (*Bx2D)(nx_p-1,j+1) -Bx_val[j+1])// Check x-index
-            +                   Epsilon_SM_E *( (*Bx2D)(nx_p-1,j) -Bx_val[j])
+            +                   Delta_SM_E   *( (*Bx2D)(nx_p-1-ghost_shift,j+1) -Bx_val[j+1])// Check x-index
+            +                   Epsilon_SM_E *( (*Bx2D)(nx_p-1-ghost_shift,j) -Bx_val[j])
             +                   By_val[j];
             
         }//j  ---end compute By
@@ -315,8 +315,8 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
             /*(*Bz2D)(nx_d-1,j) = -Alpha_SM_E * (*Ey2D)(nx_p-1,j)
              +                    Beta_SM_E  * (*Bz2D)(nx_d-2,j)
              +                    Gamma_SM_E * bzE;*/
-            (*Bz2D)(nx_d-1,j) = -Alpha_SM_E * (*Ey2D)(nx_p-1,j)
-            +                    Beta_SM_E  *( (*Bz2D)(nx_d-2,j) -Bz_val[j])
+            (*Bz2D)(nx_d-1-ghost_shift,j) = -Alpha_SM_E * (*Ey2D)(nx_p-1-ghost_shift,j)
+            +                    Beta_SM_E  *( (*Bz2D)(nx_d-2-ghost_shift,j) -Bz_val[j])
             +                    Gamma_SM_E * bzE
             +                    Bz_val[j];
             
@@ -338,10 +338,10 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
              +               Beta_SM_S    * (*Bx2D)(j,1)
              +               Delta_SM_S   * (*By2D)(j+1,0)
              +               Epsilon_SM_S * (*By2D)(j,0);*/
-            (*Bx2D)(j,0) = -Alpha_SM_S   * (*Ez2D)(j,0)
-            +               Beta_SM_S    *( (*Bx2D)(j,1)-Bx_val[j])
-            +               Delta_SM_S   *( (*By2D)(j+1,0)-By_val[j+1])
-            +               Epsilon_SM_S *( (*By2D)(j,0)-By_val[j])
+            (*Bx2D)(j,ghost_shift) = -Alpha_SM_S   * (*Ez2D)(j,ghost_shift)
+            +               Beta_SM_S    *( (*Bx2D)(j,ghost_shift+1)-Bx_val[j])
+            +               Delta_SM_S   *( (*By2D)(j+1,ghost_shift)-By_val[j+1])
+            +               Epsilon_SM_S *( (*By2D)(j,ghost_shift)-By_val[j])
             +               Bx_val[j];
         }//j  ---end Bx
         
@@ -350,8 +350,8 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int j=0 ; j<nx_d ; j++) {
             /*(*Bz2D)(j,0) = Alpha_SM_S * (*Ex2D)(j,0)
              +               Beta_SM_S * (*Bz2D)(j,1);*/
-            (*Bz2D)(j,0) = Alpha_SM_S * (*Ex2D)(j,0)
-            +               Beta_SM_S  *( (*Bz2D)(j,1)-Bz_val[j])
+            (*Bz2D)(j,ghost_shift) = Alpha_SM_S * (*Ex2D)(j,ghost_shift)
+            +               Beta_SM_S  *( (*Bz2D)(j,ghost_shift+1)-Bz_val[j])
             +               Bz_val[j];
         }//j  ---end Bz
         
@@ -372,10 +372,10 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
              +                    Beta_SM_N    * (*Bx2D)(j,ny_d-2)
              +                    Delta_SM_N   * (*By2D)(j+1,ny_p-1)
              +                    Epsilon_SM_N * (*By2D)(j,ny_p-1);*/
-            (*Bx2D)(j,ny_d-1) = -Alpha_SM_N   * (*Ez2D)(j,ny_p-1)
-            +                   Beta_SM_N    *( (*Bx2D)(j,ny_d-2) -Bx_val[j])
-            +                   Delta_SM_N   *( (*By2D)(j+1,ny_p-1) -By_val[j+1])
-            +                   Epsilon_SM_N *( (*By2D)(j,ny_p-1) -By_val[j])
+            (*Bx2D)(j,ny_d-1-ghost_shift) = -Alpha_SM_N   * (*Ez2D)(j,ny_p-1-ghost_shift)
+            +                   Beta_SM_N    *( (*Bx2D)(j,ny_d-2-ghost_shift) -Bx_val[j])
+            +                   Delta_SM_N   *( (*By2D)(j+1,ny_p-1-ghost_shift) -By_val[j+1])
+            +                   Epsilon_SM_N *( (*By2D)(j,ny_p-1-ghost_shift) -By_val[j])
             +                   Bx_val[j];
         }//j  ---end Bx
         
@@ -384,8 +384,8 @@ void ElectroMagnBC2D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int j=0 ; j<nx_d ; j++) {
             /*(*Bz2D)(j,ny_d-1) = Alpha_SM_N * (*Ex2D)(j,ny_p-1)
              +                   Beta_SM_N  * (*Bz2D)(j,ny_d-2);*/
-            (*Bz2D)(j,ny_d-1) = Alpha_SM_N * (*Ex2D)(j,ny_p-1)
-            +                   Beta_SM_N  *( (*Bz2D)(j,ny_d-2)- Bz_val[j])
+            (*Bz2D)(j,ny_d-1-ghost_shift) = Alpha_SM_N * (*Ex2D)(j,ny_p-1-ghost_shift)
+            +                   Beta_SM_N  *( (*Bz2D)(j,ny_d-2-ghost_shift)- Bz_val[j])
             +                   Bz_val[j];
         }//j  ---end Bx
         
@@ -194,13 +194,13 @@ void ElectroMagnBC3D_SM::save_fields(Field* my_field, Patch* patch) {
     if (min_max==0 && patch->isXmin() ) {
         
         if (field3D->name=="Bx"){
-            field3D->extract_slice_yz(0,      Bx_val);
+            field3D->extract_slice_yz(ghost_shift, Bx_val);
         }
         else if (field3D->name=="By"){
-            field3D->extract_slice_yz(0,      By_val);
+            field3D->extract_slice_yz(ghost_shift, By_val);
         }
         else if (field3D->name=="Bz"){
-            field3D->extract_slice_yz(0,      Bz_val);
+            field3D->extract_slice_yz(ghost_shift, Bz_val);
         }
     }
     else if (min_max==1 && patch->isXmax() ) {
@@ -216,48 +216,48 @@ void ElectroMagnBC3D_SM::save_fields(Field* my_field, Patch* patch) {
     }
     else if (min_max==2 && patch->isYmin() ) {
         if (field3D->name=="Bx"){
-            field3D->extract_slice_xz(0,      Bx_val);
+            field3D->extract_slice_xz(ghost_shift, Bx_val);
         }
         else if (field3D->name=="By"){
-            field3D->extract_slice_xz(0,      By_val);
+            field3D->extract_slice_xz(ghost_shift, By_val);
         }
         else if (field3D->name=="Bz"){
-            field3D->extract_slice_xz(0,      Bz_val);
+            field3D->extract_slice_xz(ghost_shift, Bz_val);
         }
     }
     else if (min_max==3 && patch->isYmax() ) {
         if (field3D->name=="Bx"){
-            field3D->extract_slice_xz(ny_d-1, Bx_val);
+            field3D->extract_slice_xz(ny_d-1-ghost_shift, Bx_val);
         }
         else if (field3D->name=="By"){
-            field3D->extract_slice_xz(ny_p-1, By_val);
+            field3D->extract_slice_xz(ny_p-1-ghost_shift, By_val);
         }
         else if (field3D->name=="Bz"){
-            field3D->extract_slice_xz(ny_d-1, Bz_val);
+            field3D->extract_slice_xz(ny_d-1-ghost_shift, Bz_val);
         }
     }
     else if (min_max==4 && patch->isZmin() ) {
         
         if (field3D->name=="Bx"){
-            field3D->extract_slice_xy(0,      Bx_val);
+            field3D->extract_slice_xy(ghost_shift, Bx_val);
         }
         else if (field3D->name=="By"){
-            field3D->extract_slice_xy(0,      By_val);
+            field3D->extract_slice_xy(ghost_shift, By_val);
         }
         else if (field3D->name=="Bz"){
-            field3D->extract_slice_xy(0,      Bz_val);
+            field3D->extract_slice_xy(ghost_shift, Bz_val);
         }
     }
     else if (min_max==5 && patch->isZmax() ) {
         
         if (field3D->name=="Bx"){
-            field3D->extract_slice_xy(nz_d-1, Bx_val);
+            field3D->extract_slice_xy(nz_d-1-ghost_shift, Bx_val);
         }
         else if (field3D->name=="By"){
-            field3D->extract_slice_xy(nz_d-1, By_val);
+            field3D->extract_slice_xy(nz_d-1-ghost_shift, By_val);
         }
         else if (field3D->name=="Bz"){
-            field3D->extract_slice_xy(nz_p-1, Bz_val);
+            field3D->extract_slice_xy(nz_p-1-ghost_shift, Bz_val);
         }
     }
 }
@@ -304,11 +304,11 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
                     byW += vecLaser[ilaser]->getAmplitude0(pos, time_dual, j, k);
                 }
                 
-                (*By3D)(0,j,k) = Alpha_SM_W   * (*Ez3D)(0,j,k)
-                +              Beta_SM_W    *( (*By3D)(1,j,k)-(*By_val)(j,k))
+                (*By3D)(ghost_shift,j,k) = Alpha_SM_W   * (*Ez3D)(ghost_shift,j,k)
+                +              Beta_SM_W    *( (*By3D)(ghost_shift+1,j,k)-(*By_val)(j,k))
                 +              Gamma_SM_W   * byW
-                +              Delta_SM_W   *( (*Bx3D)(0,j+1,k)-(*Bx_val)(j+1,k) )
-                +              Epsilon_SM_W *( (*Bx3D)(0,j,k)-(*Bx_val)(j,k) )
+                +              Delta_SM_W   *( (*Bx3D)(ghost_shift,j+1,k)-(*Bx_val)(j+1,k) )
+                +              Epsilon_SM_W *( (*Bx3D)(ghost_shift,j,k)-(*Bx_val)(j,k) )
                 +              (*By_val)(j,k);
             }// k  ---end compute By
         }//j  ---end compute By
@@ -326,11 +326,11 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
                     bzW += vecLaser[ilaser]->getAmplitude1(pos, time_dual, j, k);
                 }
                 
-                (*Bz3D)(0,j,k) = - Alpha_SM_W   * (*Ey3D)(0,j,k)
-                +              Beta_SM_W    *( (*Bz3D)(1,j,k)-(*Bz_val)(j,k))
+                (*Bz3D)(ghost_shift,j,k) = - Alpha_SM_W   * (*Ey3D)(ghost_shift,j,k)
+                +              Beta_SM_W    *( (*Bz3D)(ghost_shift+1,j,k)-(*Bz_val)(j,k))
                 +              Gamma_SM_W   * bzW
-                +              Zeta_SM_W   *( (*Bx3D)(0,j,k+1)-(*Bx_val)(j,k+1) )
-                +              Eta_SM_W *( (*Bx3D)(0,j,k)-(*Bx_val)(j,k) )
+                +              Zeta_SM_W   *( (*Bx3D)(ghost_shift,j,k+1)-(*Bx_val)(j,k+1) )
+                +              Eta_SM_W *( (*Bx3D)(ghost_shift,j,k)-(*Bx_val)(j,k) )
                 +              (*Bz_val)(j,k);
                 
             }// k  ---end compute Bz
@@ -361,11 +361,11 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
                     byE += vecLaser[ilaser]->getAmplitude0(pos, time_dual, j, k);
                 }
                 
-                (*By3D)(nx_d-1,j,k) = Alpha_SM_E   * (*Ez3D)(nx_p-1,j,k)
-                +                   Beta_SM_E    *( (*By3D)(nx_d-2,j,k) -(*By_val)(j,k))
+                (*By3D)(nx_d-1-ghost_shift,j,k) = Alpha_SM_E   * (*Ez3D)(nx_p-1-ghost_shift,j,k)
+                +                   Beta_SM_E    *( (*By3D)(nx_d-2-ghost_shift,j,k) -(*By_val)(j,k))
                 +                   Gamma_SM_E   * byE
-                +                   Delta_SM_E   *( (*Bx3D)(nx_p-1,j+1,k) -(*Bx_val)(j+1,k))// Check x-index
-                +                   Epsilon_SM_E *( (*Bx3D)(nx_p-1,j,k) -(*Bx_val)(j,k))
+                +                   Delta_SM_E   *( (*Bx3D)(nx_p-1-ghost_shift,j+1,k) -(*Bx_val)(j+1,k))// Check x-index
+                +                   Epsilon_SM_E *( (*Bx3D)(nx_p-1-ghost_shift,j,k) -(*Bx_val)(j,k))
                 +                   (*By_val)(j,k);
                 
             }//k  ---end compute By
@@ -384,11 +384,11 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
                     bzE += vecLaser[ilaser]->getAmplitude1(pos, time_dual, j, k);
                 }
                 
-                (*Bz3D)(nx_d-1,j,k) = -Alpha_SM_E * (*Ey3D)(nx_p-1,j,k)
-                +                    Beta_SM_E  *( (*Bz3D)(nx_d-2,j,k) -(*Bz_val)(j,k))
+                (*Bz3D)(nx_d-1-ghost_shift,j,k) = -Alpha_SM_E * (*Ey3D)(nx_p-1-ghost_shift,j,k)
+                +                    Beta_SM_E  *( (*Bz3D)(nx_d-2-ghost_shift,j,k) -(*Bz_val)(j,k))
                 +                    Gamma_SM_E * bzE
-                +                    Zeta_SM_E   *( (*Bx3D)(nx_p-1,j,k+1)-(*Bx_val)(j,k+1) )
-                +                    Eta_SM_E *( (*Bx3D)(nx_p-1,j,k)-(*Bx_val)(j,k) )
+                +                    Zeta_SM_E   *( (*Bx3D)(nx_p-1-ghost_shift,j,k+1)-(*Bx_val)(j,k+1) )
+                +                    Eta_SM_E *( (*Bx3D)(nx_p-1-ghost_shift,j,k)-(*Bx_val)(j,k) )
                 +                    (*Bz_val)(j,k);
             }//k  ---end compute Bz
         }//j  ---end compute Bz
@@ -406,10 +406,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         // for Bx^(p,d,d)
         for (unsigned int i=0 ; i<nx_p ; i++) {
             for (unsigned int k=0 ; k<nz_d ; k++) {
-                (*Bx3D)(i,0,k) = - Alpha_SM_S   * (*Ez3D)(i,0,k)
-                +              Beta_SM_S    *( (*Bx3D)(i,1,k)-(*Bx_val)(i,k))
-                +              Zeta_SM_S   *( (*By3D)(i+1,0,k)-(*By_val)(i+1,k) )
-                +              Eta_SM_S *( (*By3D)(i,0,k)-(*By_val)(i,k) )
+                (*Bx3D)(i,ghost_shift,k) = - Alpha_SM_S   * (*Ez3D)(i,ghost_shift,k)
+                +              Beta_SM_S    *( (*Bx3D)(i,ghost_shift+1,k)-(*Bx_val)(i,k))
+                +              Zeta_SM_S   *( (*By3D)(i+1,ghost_shift,k)-(*By_val)(i+1,k) )
+                +              Eta_SM_S *( (*By3D)(i,ghost_shift,k)-(*By_val)(i,k) )
                 +              (*Bx_val)(i,k);
             }// k  ---end compute Bx
         }//i  ---end compute Bx
@@ -417,10 +417,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         // for Bz^(d,d,p)
         for (unsigned int i=0 ; i<nx_d ; i++) {
             for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Bz3D)(i,0,k) = Alpha_SM_S   * (*Ex3D)(i,0,k)
-                +              Beta_SM_S    *( (*Bz3D)(i,1,k)-(*Bz_val)(i,k))
-                +              Delta_SM_S   *( (*By3D)(i,0,k+1)-(*By_val)(i,k+1) )
-                +              Epsilon_SM_S *( (*By3D)(i,0,k)-(*By_val)(i,k) )
+                (*Bz3D)(i,ghost_shift,k) = Alpha_SM_S   * (*Ex3D)(i,ghost_shift,k)
+                +              Beta_SM_S    *( (*Bz3D)(i,ghost_shift+1,k)-(*Bz_val)(i,k))
+                +              Delta_SM_S   *( (*By3D)(i,ghost_shift,k+1)-(*By_val)(i,k+1) )
+                +              Epsilon_SM_S *( (*By3D)(i,ghost_shift,k)-(*By_val)(i,k) )
                 +              (*Bz_val)(i,k);
             }// k  ---end compute Bz
         }//i  ---end compute Bz
@@ -440,10 +440,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_p ; i++) {
             for (unsigned int k=0 ; k<nz_d ; k++) {
                 
-                (*Bx3D)(i,ny_d-1,k) = -Alpha_SM_N * (*Ez3D)(i,ny_p-1,k)
-                +                    Beta_SM_N  *( (*Bx3D)(i,ny_d-2,k) -(*Bx_val)(i,k))
-                +                    Zeta_SM_N   *( (*By3D)(i+1,ny_p-1,k)-(*By_val)(i+1,k) )
-                +                    Eta_SM_N *( (*By3D)(i,ny_p-1,k)-(*By_val)(i,k) )
+                (*Bx3D)(i,ny_d-1-ghost_shift,k) = -Alpha_SM_N * (*Ez3D)(i,ny_p-1-ghost_shift,k)
+                +                    Beta_SM_N  *( (*Bx3D)(i,ny_d-2-ghost_shift,k) -(*Bx_val)(i,k))
+                +                    Zeta_SM_N   *( (*By3D)(i+1,ny_p-1-ghost_shift,k)-(*By_val)(i+1,k) )
+                +                    Eta_SM_N *( (*By3D)(i,ny_p-1-ghost_shift,k)-(*By_val)(i,k) )
                 +                    (*Bx_val)(i,k);
                 
             }//k  ---end compute Bz
@@ -453,10 +453,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_d ; i++) {
             for (unsigned int k=0 ; k<nz_p ; k++) {
                 
-                (*Bz3D)(i,ny_d-1,k) = Alpha_SM_N   * (*Ex3D)(i,ny_p-1,k)
-                +                   Beta_SM_N    *( (*Bz3D)(i,ny_d-2,k) -(*Bz_val)(i,k))
-                +                   Delta_SM_N   *( (*By3D)(i,ny_p-1,k+1) -(*By_val)(i,k+1))
-                +                   Epsilon_SM_N *( (*By3D)(i,ny_p-1,k) -(*By_val)(i,k))
+                (*Bz3D)(i,ny_d-1-ghost_shift,k) = Alpha_SM_N   * (*Ex3D)(i,ny_p-1-ghost_shift,k)
+                +                   Beta_SM_N    *( (*Bz3D)(i,ny_d-2-ghost_shift,k) -(*Bz_val)(i,k))
+                +                   Delta_SM_N   *( (*By3D)(i,ny_p-1-ghost_shift,k+1) -(*By_val)(i,k+1))
+                +                   Epsilon_SM_N *( (*By3D)(i,ny_p-1-ghost_shift,k) -(*By_val)(i,k))
                 +                   (*Bz_val)(i,k);
                 
             }//k  ---end compute Bz
@@ -476,10 +476,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_p ; i++) {
             for (unsigned int j=0 ; j<ny_d ; j++) {
                 
-                (*Bx3D)(i,j,0) = Alpha_SM_B   * (*Ey3D)(i,j,0)
-                +              Beta_SM_B    *( (*Bx3D)(i,j,1)-(*Bx_val)(i,j))
-                +              Delta_SM_B   *( (*Bz3D)(i+1,j,0)-(*Bz_val)(i+1,j) )
-                +              Epsilon_SM_B *( (*Bz3D)(i,j,0)-(*Bz_val)(i,j) )
+                (*Bx3D)(i,j,ghost_shift) = Alpha_SM_B   * (*Ey3D)(i,j,ghost_shift)
+                +              Beta_SM_B    *( (*Bx3D)(i,j,ghost_shift+1)-(*Bx_val)(i,j))
+                +              Delta_SM_B   *( (*Bz3D)(i+1,j,ghost_shift)-(*Bz_val)(i+1,j) )
+                +              Epsilon_SM_B *( (*Bz3D)(i,j,ghost_shift)-(*Bz_val)(i,j) )
                 +              (*Bx_val)(i,j);
             }// j  ---end compute Bx
         }//i  ---end compute Bx
@@ -488,10 +488,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_d ; i++) {
             for (unsigned int j=0 ; j<ny_p ; j++) {
                 
-                (*By3D)(i,j,0) = - Alpha_SM_B   * (*Ex3D)(i,j,0)
-                +              Beta_SM_B    *( (*By3D)(i,j,1)-(*By_val)(i,j))
-                +              Zeta_SM_B   *( (*Bz3D)(i,j+1,0)-(*Bz_val)(i,j+1) )
-                +              Eta_SM_B *( (*Bz3D)(i,j,0)-(*Bz_val)(i,j) )
+                (*By3D)(i,j,ghost_shift) = - Alpha_SM_B   * (*Ex3D)(i,j,ghost_shift)
+                +              Beta_SM_B    *( (*By3D)(i,j,ghost_shift+1)-(*By_val)(i,j))
+                +              Zeta_SM_B   *( (*Bz3D)(i,j+1,ghost_shift)-(*Bz_val)(i,j+1) )
+                +              Eta_SM_B *( (*Bz3D)(i,j,ghost_shift)-(*Bz_val)(i,j) )
                 +              (*By_val)(i,j);
                 
             }// j  ---end compute By
@@ -512,10 +512,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_p ; i++) {
             for (unsigned int j=0 ; j<ny_d ; j++) {
                 
-                (*Bx3D)(i,j,nz_d-1) = Alpha_SM_T   * (*Ey3D)(i,j,nz_p-1)
-                +                   Beta_SM_T    *( (*Bx3D)(i,j,nz_d-2) -(*Bx_val)(i,j))
-                +                   Delta_SM_T   *( (*Bz3D)(i+1,j,nz_p-1) -(*Bz_val)(i+1,j))
-                +                   Epsilon_SM_T *( (*Bz3D)(i,j,nz_p-1) -(*Bz_val)(i,j))
+                (*Bx3D)(i,j,nz_d-1-ghost_shift) = Alpha_SM_T   * (*Ey3D)(i,j,nz_p-1-ghost_shift)
+                +                   Beta_SM_T    *( (*Bx3D)(i,j,nz_d-2-ghost_shift) -(*Bx_val)(i,j))
+                +                   Delta_SM_T   *( (*Bz3D)(i+1,j,nz_p-1-ghost_shift) -(*Bz_val)(i+1,j))
+                +                   Epsilon_SM_T *( (*Bz3D)(i,j,nz_p-1-ghost_shift) -(*Bz_val)(i,j))
                 +                   (*Bx_val)(i,j);
                 
             }//j  ---end compute Bx
@@ -526,10 +526,10 @@ void ElectroMagnBC3D_SM::apply(ElectroMagn* EMfields, double time_dual, Patch* p
         for (unsigned int i=0 ; i<nx_d ; i++) {
             for (unsigned int j=0 ; j<ny_p ; j++) {
                 
-                (*By3D)(i,j,nz_d-1) = -Alpha_SM_T * (*Ex3D)(i,j,nz_p-1)
-                +                    Beta_SM_T  *( (*By3D)(i,j,nz_d-2) -(*By_val)(i,j))
-                +                    Zeta_SM_T   *( (*Bz3D)(i,j+1,nz_p-1)-(*Bz_val)(i,j+1) )
-                +                    Eta_SM_T *( (*Bz3D)(i,j,nz_p-1)-(*Bz_val)(i,j) )
+                (*By3D)(i,j,nz_d-1-ghost_shift) = -Alpha_SM_T * (*Ex3D)(i,j,nz_p-1-ghost_shift)
+                +                    Beta_SM_T  *( (*By3D)(i,j,nz_d-2-ghost_shift) -(*By_val)(i,j))
+                +                    Zeta_SM_T   *( (*Bz3D)(i,j+1,nz_p-1-ghost_shift)-(*Bz_val)(i,j+1) )
+                +                    Eta_SM_T *( (*Bz3D)(i,j,nz_p-1-ghost_shift)-(*Bz_val)(i,j) )
                 +                    (*By_val)(i,j);
                 
             }//j  ---end compute By
@@ -0,0 +1,95 @@
+
+#include "MAF_Solver2D_Yee.h"
+
+#include "ElectroMagn.h"
+#include "FieldView.h"
+
+#include <cstring>
+
+MAF_Solver2D_Yee::MAF_Solver2D_Yee(Params &params)
+: Solver2D(params)
+{
+}
+
+MAF_Solver2D_Yee::~MAF_Solver2D_Yee()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// For each line i along x :
+//   - save B(i) in B_m(i)
+//   - update E(i), using B(i) and B(i+1), not modified yet
+//   - update B(i), using E(i) and E(i-1), already updated ; B(i) is not used by the next lines of E
+// Same operations as MA_Solver2D_norm then MF_Solver2D_Yee, on a working set of a few lines
+// ---------------------------------------------------------------------------------------------------------------------
+void MAF_Solver2D_Yee::operator() ( ElectroMagn* fields )
+{
+    // Flat views of the fields
+    Field2DView Ex2D( fields->Ex_ );
+    Field2DView Ey2D( fields->Ey_ );
+    Field2DView Ez2D( fields->Ez_ );
+    Field2DView Bx2D( fields->Bx_ );
+    Field2DView By2D( fields->By_ );
+    Field2DView Bz2D( fields->Bz_ );
+    Field2DView Bx2D_m( fields->Bx_m );
+    Field2DView By2D_m( fields->By_m );
+    Field2DView Bz2D_m( fields->Bz_m );
+    Field2DView Jx2D( fields->Jx_ );
+    Field2DView Jy2D( fields->Jy_ );
+    Field2DView Jz2D( fields->Jz_ );
+
+    for (unsigned int i=0 ; i<nx_d ; i++) {
+
+        // Save B(i) : Bx^(p,d), By^(d,p), Bz^(d,d)
+        if (i<nx_p)
+            memcpy( &(Bx2D_m(i,0)), &(Bx2D(i,0)), ny_d*sizeof(double) );
+        memcpy( &(By2D_m(i,0)), &(By2D(i,0)), ny_p*sizeof(double) );
+        memcpy( &(Bz2D_m(i,0)), &(Bz2D(i,0)), ny_d*sizeof(double) );
+
+        // Electric field Ex^(d,p)
+        #pragma omp simd
+        for (unsigned int j=0 ; j<ny_p ; j++) {
+            Ex2D(i,j) += -dt*Jx2D(i,j) + dt_ov_dy * ( Bz2D(i,j+1) - Bz2D(i,j) );
+        }
+
+        if (i<nx_p) {
+            // Electric field Ey^(p,d)
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_d ; j++) {
+                Ey2D(i,j) += -dt*Jy2D(i,j) - dt_ov_dx * ( Bz2D(i+1,j) - Bz2D(i,j) );
+            }
+
+            // Electric field Ez^(p,p)
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                Ez2D(i,j) += -dt*Jz2D(i,j)
+                +            dt_ov_dx * ( By2D(i+1,j) - By2D(i,j) )
+                -            dt_ov_dy * ( Bx2D(i,j+1) - Bx2D(i,j) );
+            }
+
+            // Magnetic field Bx^(p,d)
+            #pragma omp simd
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                Bx2D(i,j) -= dt_ov_dy * ( Ez2D(i,j) - Ez2D(i,j-1) );
+            }
+        }
+
+        if ( (i>0) && (i<nx_d-1) ) {
+            // Magnetic field By^(d,p)
+            #pragma omp simd
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                By2D(i,j) += dt_ov_dx * ( Ez2D(i,j) - Ez2D(i-1,j) );
+            }
+
+            // Magnetic field Bz^(d,d)
+            #pragma omp simd
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                Bz2D(i,j) += dt_ov_dy * ( Ex2D(i,j) - Ex2D(i,j-1) )
+                -            dt_ov_dx * ( Ey2D(i,j) - Ey2D(i-1,j) );
+            }
+        }
+
+    } // END for i
+
+}
+
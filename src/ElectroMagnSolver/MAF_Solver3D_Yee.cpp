@@ -0,0 +1,110 @@
+
+#include "MAF_Solver3D_Yee.h"
+
+#include "ElectroMagn.h"
+#include "FieldView.h"
+
+#include <cstring>
+
+MAF_Solver3D_Yee::MAF_Solver3D_Yee(Params &params)
+: Solver3D(params)
+{
+}
+
+MAF_Solver3D_Yee::~MAF_Solver3D_Yee()
+{
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// For each plane i along x :
+//   - save B(i) in B_m(i)
+//   - update E(i), using B(i) and B(i+1), not modified yet
+//   - update B(i), using E(i) and E(i-1), already updated ; B(i) is not used by the next planes of E
+// Same operations as MA_Solver3D_norm then MF_Solver3D_Yee, on a working set of a few planes
+// ---------------------------------------------------------------------------------------------------------------------
+void MAF_Solver3D_Yee::operator() ( ElectroMagn* fields )
+{
+    // Flat views of the fields
+    Field3DView Ex3D( fields->Ex_ );
+    Field3DView Ey3D( fields->Ey_ );
+    Field3DView Ez3D( fields->Ez_ );
+    Field3DView Bx3D( fields->Bx_ );
+    Field3DView By3D( fields->By_ );
+    Field3DView Bz3D( fields->Bz_ );
+    Field3DView Bx3D_m( fields->Bx_m );
+    Field3DView By3D_m( fields->By_m );
+    Field3DView Bz3D_m( fields->Bz_m );
+    Field3DView Jx3D( fields->Jx_ );
+    Field3DView Jy3D( fields->Jy_ );
+    Field3DView Jz3D( fields->Jz_ );
+
+    for (unsigned int i=0 ; i<nx_d ; i++) {
+
+        // Save B(i) : Bx^(p,d,d), By^(d,p,d), Bz^(d,d,p)
+        if (i<nx_p)
+            memcpy( &(Bx3D_m(i,0,0)), &(Bx3D(i,0,0)), ny_d*nz_d*sizeof(double) );
+        memcpy( &(By3D_m(i,0,0)), &(By3D(i,0,0)), ny_p*nz_d*sizeof(double) );
+        memcpy( &(Bz3D_m(i,0,0)), &(Bz3D(i,0,0)), ny_d*nz_p*sizeof(double) );
+
+        // Electric field Ex^(d,p,p)
+        for (unsigned int j=0 ; j<ny_p ; j++) {
+            #pragma omp simd
+            for (unsigned int k=0 ; k<nz_p ; k++) {
+                Ex3D(i,j,k) += -dt*Jx3D(i,j,k)
+                +              dt_ov_dy * ( Bz3D(i,j+1,k) - Bz3D(i,j,k) )
+                -              dt_ov_dz * ( By3D(i,j,k+1) - By3D(i,j,k) );
+            }
+        }
+
+        if (i<nx_p) {
+            // Electric field Ey^(p,d,p)
+            for (unsigned int j=0 ; j<ny_d ; j++) {
+                #pragma omp simd
+                for (unsigned int k=0 ; k<nz_p ; k++) {
+                    Ey3D(i,j,k) += -dt*Jy3D(i,j,k)
+                    -               dt_ov_dx * ( Bz3D(i+1,j,k) - Bz3D(i,j,k) )
+                    +               dt_ov_dz * ( Bx3D(i,j,k+1) - Bx3D(i,j,k) );
+                }
+            }
+
+            // Electric field Ez^(p,p,d)
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                #pragma omp simd
+                for (unsigned int k=0 ; k<nz_d ; k++) {
+                    Ez3D(i,j,k) += -dt*Jz3D(i,j,k)
+                    +               dt_ov_dx * ( By3D(i+1,j,k) - By3D(i,j,k) )
+                    -               dt_ov_dy * ( Bx3D(i,j+1,k) - Bx3D(i,j,k) );
+                }
+            }
+
+            // Magnetic field Bx^(p,d,d)
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                #pragma omp simd
+                for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+                    Bx3D(i,j,k) += -dt_ov_dy * ( Ez3D(i,j,k) - Ez3D(i,j-1,k) ) + dt_ov_dz * ( Ey3D(i,j,k) - Ey3D(i,j,k-1) );
+                }
+            }
+        }
+
+        if ( (i>0) && (i<nx_d-1) ) {
+            // Magnetic field By^(d,p,d)
+            for (unsigned int j=0 ; j<ny_p ; j++) {
+                #pragma omp simd
+                for (unsigned int k=1 ; k<nz_d-1 ; k++) {
+                    By3D(i,j,k) += -dt_ov_dz * ( Ex3D(i,j,k) - Ex3D(i,j,k-1) ) + dt_ov_dx * ( Ez3D(i,j,k) - Ez3D(i-1,j,k) );
+                }
+            }
+
+            // Magnetic field Bz^(d,d,p)
+            for (unsigned int j=1 ; j<ny_d-1 ; j++) {
+                #pragma omp simd
+                for (unsigned int k=0 ; k<nz_p ; k++) {
+                    Bz3D(i,j,k) += -dt_ov_dx * ( Ey3D(i,j,k) - Ey3D(i-1,j,k) ) + dt_ov_dy * ( Ex3D(i,j,k) - Ex3D(i,j-1,k) );
+                }
+            }
+        }
+
+    } // END for i
+
+}
+
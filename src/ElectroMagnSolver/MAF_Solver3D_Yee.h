@@ -0,0 +1,25 @@
+#ifndef MAF_SOLVER3D_YEE_H
+#define MAF_SOLVER3D_YEE_H
+
+#include "Solver3D.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MAF_Solver3D_Yee
+//!   Fused Maxwell solver (MA_Solver3D_norm + MF_Solver3D_Yee) : save of B in B_m, E then B updated in a single
+//!   traversal of the patch, plane by plane along x, so that the fields are read from memory once per timestep
+//  --------------------------------------------------------------------------------------------------------------------
+class MAF_Solver3D_Yee : public Solver3D
+{
+
+public:
+    MAF_Solver3D_Yee(Params &params);
+    virtual ~MAF_Solver3D_Yee();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+};//END class
+
+#endif
+
@@ -14,6 +14,27 @@ MA_Solver1D_norm::~MA_Solver1D_norm()
 }
 
 void MA_Solver1D_norm::operator() ( ElectroMagn* fields )
+{
+    int parts[1] = { allCells };
+    update( fields, parts );
+}
+
+void MA_Solver1D_norm::interior( ElectroMagn* fields )
+{
+    int parts[1] = { interiorCells };
+    update( fields, parts );
+}
+
+void MA_Solver1D_norm::boundary( ElectroMagn* fields )
+{
+    int parts[1];
+    for (int ibox=0 ; ibox<2 ; ibox++) {
+        boundaryBox( ibox, 1, parts );
+        update( fields, parts );
+    }
+}
+
+void MA_Solver1D_norm::update( ElectroMagn* fields, const int* parts )
 {
     Field1D* Ex1D = static_cast<Field1D*>(fields->Ex_);
     Field1D* Ey1D = static_cast<Field1D*>(fields->Ey_);
@@ -24,15 +45,19 @@ void MA_Solver1D_norm::operator() ( ElectroMagn* fields )
     Field1D* Jy1D = static_cast<Field1D*>(fields->Jy_);
     Field1D* Jz1D = static_cast<Field1D*>(fields->Jz_);
     
+    unsigned int ix0, ix1;
+    
     // --------------------
     // Solve Maxwell-Ampere
     // --------------------
     // Calculate the electrostatic field ex on the dual grid
-    for (unsigned int ix=0 ; ix<nx_d ; ix++) {
+    cellRange( parts[0], nx_d, 0, ix0, ix1 );
+    for (unsigned int ix=ix0 ; ix<ix1 ; ix++) {
         (*Ex1D)(ix)= (*Ex1D)(ix) - dt * (*Jx1D)(ix) ;
     }
     // Transverse fields ey, ez  are defined on the primal grid
-    for (unsigned int ix=0 ; ix<nx_p ; ix++) {
+    cellRange( parts[0], nx_p, 0, ix0, ix1 );
+    for (unsigned int ix=ix0 ; ix<ix1 ; ix++) {
         (*Ey1D)(ix)= (*Ey1D)(ix) - dt_ov_dx * ( (*Bz1D)(ix+1) - (*Bz1D)(ix)) - dt * (*Jy1D)(ix) ;
         (*Ez1D)(ix)= (*Ez1D)(ix) + dt_ov_dx * ( (*By1D)(ix+1) - (*By1D)(ix)) - dt * (*Jz1D)(ix) ;
     }
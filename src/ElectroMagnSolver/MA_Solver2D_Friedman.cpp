@@ -20,6 +20,27 @@ MA_Solver2D_Friedman::~MA_Solver2D_Friedman()
 }
 
 void MA_Solver2D_Friedman::operator() ( ElectroMagn* fields )
+{
+    int parts[2] = { allCells, allCells };
+    update( fields, parts );
+}
+
+void MA_Solver2D_Friedman::interior( ElectroMagn* fields )
+{
+    int parts[2] = { interiorCells, interiorCells };
+    update( fields, parts );
+}
+
+void MA_Solver2D_Friedman::boundary( ElectroMagn* fields )
+{
+    int parts[2];
+    for (int ibox=0 ; ibox<4 ; ibox++) {
+        boundaryBox( ibox, 2, parts );
+        update( fields, parts );
+    }
+}
+
+void MA_Solver2D_Friedman::update( ElectroMagn* fields, const int* parts )
 {
 
     // Static-cast of the fields
@@ -45,9 +66,13 @@ void MA_Solver2D_Friedman::operator() ( ElectroMagn* fields )
     
     double adv = 0.;
     
+    unsigned int i0, i1, j0, j1;
+
     // Electric field Ex^(d,p)
-    for (unsigned int i=0 ; i<nx_d ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
+    cellRange( parts[0], nx_d, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
             
             adv             = -dt*(*Jx2D)(i,j) + dt_ov_dy * ( (*Bz2D)(i,j+1) - (*Bz2D)(i,j) );
             // advance electric field
@@ -63,8 +88,10 @@ void MA_Solver2D_Friedman::operator() ( ElectroMagn* fields )
     
     
     // Electric field Ey^(p,d)
-    for (unsigned int i=0 ; i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_d ; j++) {
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_d, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
             
             adv             = -dt*(*Jy2D)(i,j) - dt_ov_dx * ( (*Bz2D)(i+1,j) - (*Bz2D)(i,j) );
             // advance electric field
@@ -80,8 +107,10 @@ void MA_Solver2D_Friedman::operator() ( ElectroMagn* fields )
     
     
     // Electric field Ez^(p,p)
-    for (unsigned int i=0 ;  i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
             
             adv             = -dt*(*Jz2D)(i,j)
             +                 dt_ov_dx * ( (*By2D)(i+1,j) - (*By2D)(i,j) )
@@ -17,6 +17,9 @@ public:
 
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields);
+    //! see Solver::interior
+    virtual void interior( ElectroMagn* fields );
+    virtual void boundary( ElectroMagn* fields );
     
     //! parameter for time-filtering
     double ftheta;
@@ -25,6 +28,8 @@ public:
     double delta;
 
 protected:
+    //! see Solver::interior
+    void update( ElectroMagn* fields, const int* parts );
 
 };//END class
 
@@ -2,7 +2,7 @@
 #include "MA_Solver2D_norm.h"
 
 #include "ElectroMagn.h"
-#include "Field2D.h"
+#include "FieldView.h"
 
 MA_Solver2D_norm::MA_Solver2D_norm(Params &params)
 : Solver2D(params)
@@ -15,37 +15,70 @@ MA_Solver2D_norm::~MA_Solver2D_norm()
 
 void MA_Solver2D_norm::operator() ( ElectroMagn* fields )
 {
+    int parts[2] = { allCells, allCells };
+    update( fields, parts );
+}
+
+void MA_Solver2D_norm::interior( ElectroMagn* fields )
+{
+    int parts[2] = { interiorCells, interiorCells };
+    update( fields, parts );
+}
+
+void MA_Solver2D_norm::boundary( ElectroMagn* fields )
+{
+    int parts[2];
+    for (int ibox=0 ; ibox<4 ; ibox++) {
+        boundaryBox( ibox, 2, parts );
+        update( fields, parts );
+    }
+}
+
+void MA_Solver2D_norm::update( ElectroMagn* fields, const int* parts )
+{
+
+    // Flat views of the fields
+    Field2DView Ex2D( fields->Ex_ );
+    Field2DView Ey2D( fields->Ey_ );
+    Field2DView Ez2D( fields->Ez_ );
+    Field2DView Bx2D( fields->Bx_ );
+    Field2DView By2D( fields->By_ );
+    Field2DView Bz2D( fields->Bz_ );
+    Field2DView Jx2D( fields->Jx_ );
+    Field2DView Jy2D( fields->Jy_ );
+    Field2DView Jz2D( fields->Jz_ );
+    
+    unsigned int i0, i1, j0, j1;
 
-    // Static-cast of the fields
-    Field2D* Ex2D = static_cast<Field2D*>(fields->Ex_);
-    Field2D* Ey2D = static_cast<Field2D*>(fields->Ey_);
-    Field2D* Ez2D = static_cast<Field2D*>(fields->Ez_);
-    Field2D* Bx2D = static_cast<Field2D*>(fields->Bx_);
-    Field2D* By2D = static_cast<Field2D*>(fields->By_);
-    Field2D* Bz2D = static_cast<Field2D*>(fields->Bz_);
-    Field2D* Jx2D = static_cast<Field2D*>(fields->Jx_);
-    Field2D* Jy2D = static_cast<Field2D*>(fields->Jy_);
-    Field2D* Jz2D = static_cast<Field2D*>(fields->Jz_);
     // Electric field Ex^(d,p)
-    for (unsigned int i=0 ; i<nx_d ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            (*Ex2D)(i,j) += -dt*(*Jx2D)(i,j) + dt_ov_dy * ( (*Bz2D)(i,j+1) - (*Bz2D)(i,j) );
+    cellRange( parts[0], nx_d, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        #pragma omp simd
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            Ex2D(i,j) += -dt*Jx2D(i,j) + dt_ov_dy * ( Bz2D(i,j+1) - Bz2D(i,j) );
         }
     }
     
     // Electric field Ey^(p,d)
-    for (unsigned int i=0 ; i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_d ; j++) {
-            (*Ey2D)(i,j) += -dt*(*Jy2D)(i,j) - dt_ov_dx * ( (*Bz2D)(i+1,j) - (*Bz2D)(i,j) );
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_d, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        #pragma omp simd
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            Ey2D(i,j) += -dt*Jy2D(i,j) - dt_ov_dx * ( Bz2D(i+1,j) - Bz2D(i,j) );
         }
     }
     
     // Electric field Ez^(p,p)
-    for (unsigned int i=0 ;  i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            (*Ez2D)(i,j) += -dt*(*Jz2D)(i,j)
-            +               dt_ov_dx * ( (*By2D)(i+1,j) - (*By2D)(i,j) )
-            -               dt_ov_dy * ( (*Bx2D)(i,j+1) - (*Bx2D)(i,j) );
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        #pragma omp simd
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            Ez2D(i,j) += -dt*Jz2D(i,j)
+            +            dt_ov_dx * ( By2D(i+1,j) - By2D(i,j) )
+            -            dt_ov_dy * ( Bx2D(i,j+1) - Bx2D(i,j) );
         }
     }
 
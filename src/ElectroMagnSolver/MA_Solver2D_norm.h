@@ -17,8 +17,13 @@ public:
 
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields);
+    //! see Solver::interior
+    virtual void interior( ElectroMagn* fields );
+    virtual void boundary( ElectroMagn* fields );
 
 protected:
+    //! see Solver::interior
+    void update( ElectroMagn* fields, const int* parts );
 
 };//END class
 
@@ -2,7 +2,7 @@
 #include "MA_Solver3D_norm.h"
 
 #include "ElectroMagn.h"
-#include "Field3D.h"
+#include "FieldView.h"
 
 MA_Solver3D_norm::MA_Solver3D_norm(Params &params)
 : Solver3D(params)
@@ -15,47 +15,82 @@ MA_Solver3D_norm::~MA_Solver3D_norm()
 
 void MA_Solver3D_norm::operator() ( ElectroMagn* fields )
 {
+    int parts[3] = { allCells, allCells, allCells };
+    update( fields, parts );
+}
+
+void MA_Solver3D_norm::interior( ElectroMagn* fields )
+{
+    int parts[3] = { interiorCells, interiorCells, interiorCells };
+    update( fields, parts );
+}
+
+void MA_Solver3D_norm::boundary( ElectroMagn* fields )
+{
+    int parts[3];
+    for (int ibox=0 ; ibox<6 ; ibox++) {
+        boundaryBox( ibox, 3, parts );
+        update( fields, parts );
+    }
+}
+
+void MA_Solver3D_norm::update( ElectroMagn* fields, const int* parts )
+{
+
+    // Flat views of the fields
+    Field3DView Ex3D( fields->Ex_ );
+    Field3DView Ey3D( fields->Ey_ );
+    Field3DView Ez3D( fields->Ez_ );
+    Field3DView Bx3D( fields->Bx_ );
+    Field3DView By3D( fields->By_ );
+    Field3DView Bz3D( fields->Bz_ );
+    Field3DView Jx3D( fields->Jx_ );
+    Field3DView Jy3D( fields->Jy_ );
+    Field3DView Jz3D( fields->Jz_ );
 
-    // Static-cast of the fields
-    Field3D* Ex3D = static_cast<Field3D*>(fields->Ex_);
-    Field3D* Ey3D = static_cast<Field3D*>(fields->Ey_);
-    Field3D* Ez3D = static_cast<Field3D*>(fields->Ez_);
-    Field3D* Bx3D = static_cast<Field3D*>(fields->Bx_);
-    Field3D* By3D = static_cast<Field3D*>(fields->By_);
-    Field3D* Bz3D = static_cast<Field3D*>(fields->Bz_);
-    Field3D* Jx3D = static_cast<Field3D*>(fields->Jx_);
-    Field3D* Jy3D = static_cast<Field3D*>(fields->Jy_);
-    Field3D* Jz3D = static_cast<Field3D*>(fields->Jz_);
+    unsigned int i0, i1, j0, j1, k0, k1;
 
     // Electric field Ex^(d,p,p)
-    for (unsigned int i=0 ; i<nx_d ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Ex3D)(i,j,k) += -dt*(*Jx3D)(i,j,k)
-                +                 dt_ov_dy * ( (*Bz3D)(i,j+1,k) - (*Bz3D)(i,j,k) )
-                -                 dt_ov_dz * ( (*By3D)(i,j,k+1) - (*By3D)(i,j,k) );
+    cellRange( parts[0], nx_d, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    cellRange( parts[2], nz_p, 2, k0, k1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            #pragma omp simd
+            for (unsigned int k=k0 ; k<k1 ; k++) {
+                Ex3D(i,j,k) += -dt*Jx3D(i,j,k)
+                +              dt_ov_dy * ( Bz3D(i,j+1,k) - Bz3D(i,j,k) )
+                -              dt_ov_dz * ( By3D(i,j,k+1) - By3D(i,j,k) );
             }
         }
     }
     
     // Electric field Ey^(p,d,p)
-    for (unsigned int i=0 ; i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_d ; j++) {
-            for (unsigned int k=0 ; k<nz_p ; k++) {
-                (*Ey3D)(i,j,k) += -dt*(*Jy3D)(i,j,k)
-                -                  dt_ov_dx * ( (*Bz3D)(i+1,j,k) - (*Bz3D)(i,j,k) )
-                +                  dt_ov_dz * ( (*Bx3D)(i,j,k+1) - (*Bx3D)(i,j,k) );
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_d, 1, j0, j1 );
+    cellRange( parts[2], nz_p, 2, k0, k1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            #pragma omp simd
+            for (unsigned int k=k0 ; k<k1 ; k++) {
+                Ey3D(i,j,k) += -dt*Jy3D(i,j,k)
+                -               dt_ov_dx * ( Bz3D(i+1,j,k) - Bz3D(i,j,k) )
+                +               dt_ov_dz * ( Bx3D(i,j,k+1) - Bx3D(i,j,k) );
             }
         }
     }
     
     // Electric field Ez^(p,p,d)
-    for (unsigned int i=0 ;  i<nx_p ; i++) {
-        for (unsigned int j=0 ; j<ny_p ; j++) {
-            for (unsigned int k=0 ; k<nz_d ; k++) {
-                (*Ez3D)(i,j,k) += -dt*(*Jz3D)(i,j,k)
-                +                  dt_ov_dx * ( (*By3D)(i+1,j,k) - (*By3D)(i,j,k) )
-                -                  dt_ov_dy * ( (*Bx3D)(i,j+1,k) - (*Bx3D)(i,j,k) );
+    cellRange( parts[0], nx_p, 0, i0, i1 );
+    cellRange( parts[1], ny_p, 1, j0, j1 );
+    cellRange( parts[2], nz_d, 2, k0, k1 );
+    for (unsigned int i=i0 ; i<i1 ; i++) {
+        for (unsigned int j=j0 ; j<j1 ; j++) {
+            #pragma omp simd
+            for (unsigned int k=k0 ; k<k1 ; k++) {
+                Ez3D(i,j,k) += -dt*Jz3D(i,j,k)
+                +               dt_ov_dx * ( By3D(i+1,j,k) - By3D(i,j,k) )
+                -               dt_ov_dy * ( Bx3D(i,j+1,k) - Bx3D(i,j,k) );
             }
         }
     }
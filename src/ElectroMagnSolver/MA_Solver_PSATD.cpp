@@ -0,0 +1,48 @@
+#ifdef _FFTW
+
+#include "MA_Solver_PSATD.h"
+
+#include "ElectroMagn.h"
+#include "Field.h"
+
+MA_Solver_PSATD::MA_Solver_PSATD(Params &params)
+: Solver(params), grid_(params)
+{
+    for (int i=0 ; i<3 ; i++)
+        hat_[i] = grid_.allocate();
+    curl_ = grid_.allocate();
+    dt = params.timestep;
+}
+
+MA_Solver_PSATD::~MA_Solver_PSATD()
+{
+    for (int i=0 ; i<3 ; i++)
+        fftw_free( hat_[i] );
+    fftw_free( curl_ );
+}
+
+void MA_Solver_PSATD::operator() ( ElectroMagn* fields )
+{
+    Field* E[3] = { fields->Ex_, fields->Ey_, fields->Ez_ };
+    Field* B[3] = { fields->Bx_, fields->By_, fields->Bz_ };
+    Field* J[3] = { fields->Jx_, fields->Jy_, fields->Jz_ };
+
+    for (int i=0 ; i<3 ; i++)
+        grid_.forward( B[i], hat_[i] );
+
+    for (int i=0 ; i<3 ; i++) {
+        // Current : E^(n+1) = E^n - dt J^(n+1/2) on all the points
+        double* e = E[i]->data_;
+        double* j = J[i]->data_;
+        #pragma omp simd
+        for (unsigned int ip=0 ; ip<E[i]->globalDims_ ; ip++)
+            e[ip] -= dt*j[ip];
+
+        // Curl of B^(n+1/2), from the dual grids of B to the grids of E
+        grid_.curl( hat_, i, 1, curl_ );
+        grid_.backwardAdd( curl_, E[i], dt );
+    }
+
+}
+
+#endif
@@ -0,0 +1,41 @@
+#ifndef MA_SOLVER_PSATD_H
+#define MA_SOLVER_PSATD_H
+
+#ifdef _FFTW
+
+#include <complex>
+
+#include "Solver.h"
+#include "SpectralGrid.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MA_Solver_PSATD
+//!   Spectral Maxwell-Ampere solver (2d3v and 3d3v) : E += dt ( curl B - J ), the curl computed with local transforms
+//!   of the patch (see SpectralGrid).
+//!   Despite its name, this is not the analytical time integration of the PSATD solvers : the time integration is the
+//!   leapfrog of the Yee solver, with a curl corrected by sin(w dt/2)/(w dt/2). The propagation in vacuum is the same,
+//!   the currents are applied as in the Yee solver
+//  --------------------------------------------------------------------------------------------------------------------
+class MA_Solver_PSATD : public Solver
+{
+
+public:
+    MA_Solver_PSATD(Params &params);
+    virtual ~MA_Solver_PSATD();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+private:
+    SpectralGrid grid_;
+    //! Transforms of Bx, By, Bz and of a component of the curl
+    std::complex<double>* hat_[3];
+    std::complex<double>* curl_;
+    double dt;
+
+};//END class
+
+#endif
+
+#endif
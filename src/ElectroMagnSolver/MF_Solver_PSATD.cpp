@@ -0,0 +1,40 @@
+#ifdef _FFTW
+
+#include "MF_Solver_PSATD.h"
+
+#include "ElectroMagn.h"
+#include "Field.h"
+
+MF_Solver_PSATD::MF_Solver_PSATD(Params &params)
+: Solver(params), grid_(params)
+{
+    for (int i=0 ; i<3 ; i++)
+        hat_[i] = grid_.allocate();
+    curl_ = grid_.allocate();
+    dt = params.timestep;
+}
+
+MF_Solver_PSATD::~MF_Solver_PSATD()
+{
+    for (int i=0 ; i<3 ; i++)
+        fftw_free( hat_[i] );
+    fftw_free( curl_ );
+}
+
+void MF_Solver_PSATD::operator() ( ElectroMagn* fields )
+{
+    Field* E[3] = { fields->Ex_, fields->Ey_, fields->Ez_ };
+    Field* B[3] = { fields->Bx_, fields->By_, fields->Bz_ };
+
+    for (int i=0 ; i<3 ; i++)
+        grid_.forward( E[i], hat_[i] );
+
+    // Curl of E^(n+1), from the primal grids of E to the grids of B
+    for (int i=0 ; i<3 ; i++) {
+        grid_.curl( hat_, i, 0, curl_ );
+        grid_.backwardAdd( curl_, B[i], -dt );
+    }
+
+}
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef MF_SOLVER_PSATD_H
+#define MF_SOLVER_PSATD_H
+
+#ifdef _FFTW
+
+#include <complex>
+
+#include "Solver.h"
+#include "SpectralGrid.h"
+class ElectroMagn;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class MF_Solver_PSATD
+//!   Spectral Maxwell-Faraday solver (2d3v and 3d3v) : B -= dt curl E, the curl computed with local transforms of the
+//!   patch (see SpectralGrid). The ghost cells of E must be exchanged after MA_Solver_PSATD
+//  --------------------------------------------------------------------------------------------------------------------
+class MF_Solver_PSATD : public Solver
+{
+
+public:
+    MF_Solver_PSATD(Params &params);
+    virtual ~MF_Solver_PSATD();
+
+    //! Overloading of () operator
+    virtual void operator()( ElectroMagn* fields);
+
+private:
+    SpectralGrid grid_;
+    //! Transforms of Ex, Ey, Ez and of a component of the curl
+    std::complex<double>* hat_[3];
+    std::complex<double>* curl_;
+    double dt;
+
+};//END class
+
+#endif
+
+#endif
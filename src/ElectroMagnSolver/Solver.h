@@ -5,6 +5,14 @@
 
 class ElectroMagn;
 
+//! Part of the cells of a field in a direction, for the split-phase solvers (see Solver::interior)
+enum cellsPart {
+    allCells = 0,
+    interiorCells,  //!< out of the ghost layers
+    lowCells,       //!< ghost layer at the beginning of the direction
+    highCells       //!< ghost layer at the end of the direction
+};
+
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class Solver
 //  --------------------------------------------------------------------------------------------------------------------
@@ -13,13 +21,51 @@ class Solver
 
 public:
     //! Creator for Solver
-    Solver(Params &params) {};
+    Solver(Params &params) : oversize_( params.oversize ) {};
     virtual ~Solver() {};
 
     //! Overloading of () operator
     virtual void operator()( ElectroMagn* fields) = 0;
 
+    //! Split-phase solver, to update the fields while the ghost cells of the currents are being exchanged :
+    //!   - interior : cells out of the ghost layers (oversize cells on each side), independent of the exchange
+    //!   - boundary : cells of the ghost layers, once the exchange finalized
+    //! The solvers which split their update do it box by box, each box being a part of the cells per direction
+    //! (see cellsPart, boundaryBox). By default, not split : nothing before the exchange is finalized, all the cells
+    //! updated by boundary
+    virtual void interior( ElectroMagn* fields ) {}
+    virtual void boundary( ElectroMagn* fields ) { (*this)( fields ); }
+
 protected:
+    //! Range [start, end) of a part of the n cells of direction iDim
+    inline void cellRange( int part, unsigned int n, int iDim, unsigned int& start, unsigned int& end ) {
+        start = 0;
+        end   = n;
+        if ( part == interiorCells ) {
+            start = oversize_[iDim];
+            end   = n - oversize_[iDim];
+        }
+        else if ( part == lowCells )
+            end   = oversize_[iDim];
+        else if ( part == highCells )
+            start = n - oversize_[iDim];
+    }
+
+    //! The ghost layers are covered by 2*nDim boxes, without overlap : ibox = 2*iDim+side is the layer of side
+    //! in direction iDim, restricted to the interior cells in the previous directions
+    inline void boundaryBox( int ibox, int nDim, int* parts ) {
+        for (int iDim=0 ; iDim<nDim ; iDim++) {
+            if ( iDim < ibox/2 )
+                parts[iDim] = interiorCells;
+            else if ( iDim == ibox/2 )
+                parts[iDim] = ( ibox%2 ? highCells : lowCells );
+            else
+                parts[iDim] = allCells;
+        }
+    }
+
+    //! Number of ghost cells
+    std::vector<unsigned int> oversize_;
 
 };//END class
 
@@ -12,6 +12,10 @@
 #include "MF_Solver2D_GrassiSpL.h"
 #include "MF_Solver2D_Cowan.h"
 #include "MF_Solver2D_Lehe.h"
+#include "MAF_Solver2D_Yee.h"
+#include "MAF_Solver3D_Yee.h"
+#include "MA_Solver_PSATD.h"
+#include "MF_Solver_PSATD.h"
 
 #include "Params.h"
 
@@ -26,7 +30,11 @@ public:
         Solver* solver = NULL;
         DEBUG(params.maxwell_sol);
         
-        if ( params.geometry == "1d3v" ) {
+        if ( params.maxwell_sol == "PSATD" ) {
+#ifdef _FFTW
+            solver = new MA_Solver_PSATD(params);
+#endif
+        } else if ( params.geometry == "1d3v" ) {
             solver = new MA_Solver1D_norm(params);
         } else if ( params.geometry == "2d3v" ) {
             if (params.Friedman_filter) {
@@ -52,7 +60,11 @@ public:
         
         // Create the required solver for Faraday's Equation
         // -------------------------------------------------
-        if ( params.geometry == "1d3v" ) {
+        if ( params.maxwell_sol == "PSATD" ) {
+#ifdef _FFTW
+            solver = new MF_Solver_PSATD(params);
+#endif
+        } else if ( params.geometry == "1d3v" ) {
             if (params.maxwell_sol == "Yee") {
                 solver = new MF_Solver1D_Yee(params);
             }
@@ -81,6 +93,23 @@ public:
         return solver;
     };
     
+    // Create the fused Maxwell-Ampere and Maxwell-Faraday solver
+    // ----------------------------------------------------------
+    //   NULL if not available for the solvers of the namelist : MA and MF solvers applied one after the other
+    static Solver* createMAF(Params& params) {
+        Solver* solver = NULL;
+        
+        if ( params.maxwell_sol != "Yee" || params.Friedman_filter ) return solver;
+        
+        if ( params.geometry == "2d3v" ) {
+            solver = new MAF_Solver2D_Yee(params);
+        } else if ( params.geometry == "3d3v" ) {
+            solver = new MAF_Solver3D_Yee(params);
+        }
+        
+        return solver;
+    };
+    
 };
 
 #endif
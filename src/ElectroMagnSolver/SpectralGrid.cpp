@@ -0,0 +1,154 @@
+#ifdef _FFTW
+
+#include "SpectralGrid.h"
+
+#include <cmath>
+
+#include "Field.h"
+
+using namespace std;
+
+SpectralGrid::SpectralGrid( Params& params )
+{
+    int rank = params.nDim_field;
+    nr_ = 1;
+    nk_ = 1;
+    for (int iDim=0 ; iDim<3 ; iDim++) {
+        n_[iDim]     = ( iDim<rank ? params.n_space[iDim]+1+2*params.oversize[iDim] : 1 );
+        kdims_[iDim] = ( iDim==rank-1 ? n_[iDim]/2+1 : n_[iDim] );
+        nr_ *= n_[iDim];
+        nk_ *= kdims_[iDim];
+    }
+
+    // Staggered finite differences of order psatd_order : the derivative on one grid uses the p = psatd_order/2
+    // nearest points of the other grid on each side, f' = sum_m coef_m ( f(x+(m-1/2)dx) - f(x-(m-1/2)dx) ) / dx
+    int p = params.psatd_order/2;
+    vector<double> coef( p );
+    for (int m=1 ; m<=p ; m++) {
+        coef[m-1] = 1./(2*m-1);
+        for (int l=1 ; l<=p ; l++)
+            if ( l!=m ) coef[m-1] *= (double)( (2*l-1)*(2*l-1) ) / ( (2*l-1)*(2*l-1) - (2*m-1)*(2*m-1) );
+    }
+
+    // Wave numbers : index m <-> 2 pi m / (n dx), negative beyond n/2 except in the halved direction.
+    // The transforms of the finite differences are exact : the periodicity of the box only affects the p points
+    // at its edges, which are ghost cells
+    vector<double> k[3];
+    const complex<double> I(0.,1.);
+    for (int iDim=0 ; iDim<3 ; iDim++) {
+        k[iDim].resize( kdims_[iDim], 0. );
+        D_[iDim][0].resize( kdims_[iDim], 0. );
+        D_[iDim][1].resize( kdims_[iDim], 0. );
+        if ( iDim>=rank ) continue;
+        double dx = params.cell_length[iDim];
+        for (unsigned int m=0 ; m<kdims_[iDim] ; m++) {
+            int ms = ( (iDim<rank-1) && ((int)m > n_[iDim]/2) ) ? (int)m-n_[iDim] : (int)m;
+            double kdx = 2.*M_PI*ms / n_[iDim];
+            // Modified wave number of the finite differences
+            double s = 0.;
+            for (int l=1 ; l<=p ; l++)
+                s += coef[l-1] * sin( (l-0.5)*kdx );
+            k[iDim][m] = 2.*s / dx;
+            // The dual grid is shifted by -dx/2 from the primal grid
+            D_[iDim][0][m] = I*k[iDim][m] * exp( -0.5*I*kdx );
+            D_[iDim][1][m] = I*k[iDim][m] * exp(  0.5*I*kdx );
+        }
+    }
+
+    T_.resize( nk_ );
+    double dt = params.timestep;
+    unsigned int idx = 0;
+    for (unsigned int a=0 ; a<kdims_[0] ; a++)
+        for (unsigned int b=0 ; b<kdims_[1] ; b++)
+            for (unsigned int c=0 ; c<kdims_[2] ; c++) {
+                double wdt = 0.5*dt*sqrt( k[0][a]*k[0][a] + k[1][b]*k[1][b] + k[2][c]*k[2][c] );
+                T_[idx++] = ( wdt > 0. ? sin(wdt)/wdt : 1. );
+            }
+
+    real_ = (double*) fftw_malloc( nr_*sizeof(double) );
+    complex<double>* hat = allocate();
+    // The planner is not thread safe
+    #pragma omp critical (fftw_planner)
+    {
+        forward_plan_  = fftw_plan_dft_r2c( rank, n_, real_, reinterpret_cast<fftw_complex*>(hat), FFTW_ESTIMATE );
+        backward_plan_ = fftw_plan_dft_c2r( rank, n_, reinterpret_cast<fftw_complex*>(hat), real_, FFTW_ESTIMATE );
+    }
+    fftw_free( hat );
+
+}
+
+
+SpectralGrid::~SpectralGrid()
+{
+    #pragma omp critical (fftw_planner)
+    {
+        fftw_destroy_plan( forward_plan_ );
+        fftw_destroy_plan( backward_plan_ );
+    }
+    fftw_free( real_ );
+}
+
+
+complex<double>* SpectralGrid::allocate()
+{
+    return (complex<double>*) fftw_malloc( nk_*sizeof(complex<double>) );
+}
+
+
+void SpectralGrid::forward( Field* f, complex<double>* hat )
+{
+    unsigned int dims[3] = { 1, 1, 1 };
+    for (unsigned int iDim=0 ; iDim<f->dims_.size() ; iDim++) dims[iDim] = f->dims_[iDim];
+
+    double* r = real_;
+    for (int i=0 ; i<n_[0] ; i++)
+        for (int j=0 ; j<n_[1] ; j++) {
+            double* row = f->data_ + (i*dims[1]+j)*dims[2];
+            for (int k=0 ; k<n_[2] ; k++)
+                *(r++) = row[k];
+        }
+
+    fftw_execute_dft_r2c( forward_plan_, real_, reinterpret_cast<fftw_complex*>(hat) );
+
+}
+
+
+void SpectralGrid::backwardAdd( complex<double>* hat, Field* f, double coef )
+{
+    fftw_execute_dft_c2r( backward_plan_, reinterpret_cast<fftw_complex*>(hat), real_ );
+
+    unsigned int dims[3] = { 1, 1, 1 };
+    for (unsigned int iDim=0 ; iDim<f->dims_.size() ; iDim++) dims[iDim] = f->dims_[iDim];
+
+    // Transforms not normalized by FFTW. The points of the dual grids beyond the box are periodic images
+    double c = coef / nr_;
+    for (unsigned int i=0 ; i<dims[0] ; i++)
+        for (unsigned int j=0 ; j<dims[1] ; j++) {
+            double* row = f->data_ + (i*dims[1]+j)*dims[2];
+            double* r   = real_ + ( (i%n_[0])*n_[1] + j%n_[1] )*n_[2];
+            for (unsigned int k=0 ; k<dims[2] ; k++)
+                row[k] += c * r[k%n_[2]];
+        }
+
+}
+
+
+void SpectralGrid::curl( complex<double>** hat, int icomp, int fromDual, complex<double>* out )
+{
+    // out_i = d_j hat_k - d_k hat_j, (i,j,k) circular permutation of (x,y,z)
+    int jcomp = (icomp+1)%3;
+    int kcomp = (icomp+2)%3;
+    complex<double>* hj = hat[jcomp];
+    complex<double>* hk = hat[kcomp];
+    unsigned int idx[3];
+    unsigned int i = 0;
+    for (idx[0]=0 ; idx[0]<kdims_[0] ; idx[0]++)
+        for (idx[1]=0 ; idx[1]<kdims_[1] ; idx[1]++)
+            for (idx[2]=0 ; idx[2]<kdims_[2] ; idx[2]++) {
+                out[i] = T_[i] * ( D_[jcomp][fromDual][idx[jcomp]] * hk[i] - D_[kcomp][fromDual][idx[kcomp]] * hj[i] );
+                i++;
+            }
+
+}
+
+#endif
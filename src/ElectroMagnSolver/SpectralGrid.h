@@ -0,0 +1,69 @@
+#ifndef SPECTRALGRID_H
+#define SPECTRALGRID_H
+
+#ifdef _FFTW
+
+#include <complex>
+#include <vector>
+
+#include <fftw3.h>
+
+#include "Params.h"
+
+class Field;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class SpectralGrid
+//!   Local transforms (FFTW, real to complex) of the fields of a patch for the spectral solver (see MA_Solver_PSATD) :
+//!   - the box transformed is the primal grid of the patch, ghost cells included (n_space+1+2*oversize points per
+//!     direction), assumed periodic
+//!   - the dual grids use the same box, shifted by half a cell : their last point is the periodic image of the first
+//!   - derivatives of finite order psatd_order, the shift between primal and dual grids included : they use
+//!     psatd_order/2 points on each side, so that the jump of the fields at the edges of the periodic box only affects
+//!     the ghost cells. The time factor spreads it further, but decreases quickly with the distance : the ghost cells
+//!     beyond psatd_order/2 absorb it
+//  --------------------------------------------------------------------------------------------------------------------
+class SpectralGrid
+{
+public:
+    SpectralGrid( Params& params );
+    ~SpectralGrid();
+
+    //! Number of points of the spectra
+    inline unsigned int size() { return nk_; }
+    //! New spectrum, to free with fftw_free
+    std::complex<double>* allocate();
+
+    //! hat = transform of the box of field f
+    void forward( Field* f, std::complex<double>* hat );
+    //! f += coef * inverse transform of hat, on all the points of f (hat is modified)
+    void backwardAdd( std::complex<double>* hat, Field* f, double coef );
+
+    //! out = time factor * component icomp of the curl of (hat[0], hat[1], hat[2]), defined on grids dual (fromDual=1)
+    //! or primal (fromDual=0) in the directions of the derivatives
+    void curl( std::complex<double>** hat, int icomp, int fromDual, std::complex<double>* out );
+
+private:
+    //! Number of points of the box in each direction, 1 beyond the dimension of the simulation
+    int n_[3];
+    //! Number of points of the spectra in each direction (the last direction of the simulation halved by symmetry)
+    unsigned int kdims_[3];
+    unsigned int nr_, nk_;
+
+    //! Derivative in direction iDim : D_[iDim][0] from primal to dual grid, D_[iDim][1] from dual to primal grid,
+    //! as a function of the index of the wave number in this direction
+    std::vector< std::complex<double> > D_[3][2];
+    //! Time factor sin(w dt/2)/(w dt/2), w the modified wave number of the derivatives : the leapfrog time integration
+    //! with the derivatives multiplied by this factor propagates the waves with the dispersion of the spatial
+    //! derivatives only, for any timestep
+    std::vector<double> T_;
+
+    double* real_;
+    fftw_plan forward_plan_;
+    fftw_plan backward_plan_;
+
+};
+
+#endif
+
+#endif
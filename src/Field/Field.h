@@ -34,22 +34,22 @@ public:
     std::string name;
     
     //! Constructor for Field: with no input argument
-    Field() {
+    Field() : own_data_(true) {
     };
     
     //! Constructor for Field: with the Field dimensions as input argument
-    Field( std::vector<unsigned int> dims ) {
+    Field( std::vector<unsigned int> dims ) : own_data_(true) {
     };
     //! Constructor, isPrimal define if mainDim is Primal or Dual
-    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal ) {
+    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal ) : own_data_(true) {
     };
     
     //! Constructor for Field: with the Field dimensions and dump file name as input argument
-    Field( std::vector<unsigned int> dims, std::string name_in ) : name(name_in) {
+    Field( std::vector<unsigned int> dims, std::string name_in ) : name(name_in), own_data_(true) {
     } ;
     
     //! Constructor for Field: isPrimal define if mainDim is Primal or Dual
-    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal, std::string name_in ) : name(name_in) {
+    Field( std::vector<unsigned int> dims, unsigned int mainDim, bool isPrimal, std::string name_in ) : name(name_in), own_data_(true) {
     } ;
     
     //! Destructor for Field
@@ -68,6 +68,9 @@ public:
     //! Virtual method to deallocate Field
     virtual void deallocateDims() = 0;
     
+    //! Move the values of the allocated Field to data (globalDims_ values, not owned by the Field, see FieldArena)
+    virtual void relocate( double* data ) = 0;
+    
     //! Virtual method used to make a dump of the Field data
     virtual void dump(std::vector<unsigned int> dims) = 0;
     
@@ -98,6 +101,8 @@ public:
     double* data_;
     
     inline double* data() {return data_;}
+    //! false if data_ is owned by a FieldArena
+    bool own_data_;
     //! reference access to the linearized array (with check in DEBUG mode)
     inline double& operator () (unsigned int i)
     {
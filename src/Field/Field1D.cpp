@@ -54,7 +54,7 @@ Field1D::Field1D(string name, vector<unsigned int> dims) : Field(dims, name)
 Field1D::~Field1D()
 {
     if (data_!=NULL) {
-        delete [] data_;
+        if (own_data_) delete [] data_;
     }
 }
 
@@ -70,6 +70,7 @@ void Field1D::allocateDims()
     isDual_.resize( dims_.size(), 0 );
     
     data_ = new double[ dims_[0] ];
+    own_data_ = true;
     //! \todo{change to memset (JD)}
     for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
     
@@ -79,7 +80,7 @@ void Field1D::allocateDims()
 
 void Field1D::deallocateDims()
 {
-    delete [] data_;
+    if (own_data_) delete [] data_;
     data_=NULL;
 }
 
@@ -114,6 +115,7 @@ void Field1D::allocateDims(unsigned int mainDim, bool isPrimal)
         dims_[j] += isDual_[j];
     
     data_ = new double[ dims_[0] ];
+    own_data_ = true;
     //! \todo{change to memset (JD)}
     for (unsigned int i=0; i<dims_[0]; i++) data_[i]=0.0;
     
@@ -122,6 +124,18 @@ void Field1D::allocateDims(unsigned int mainDim, bool isPrimal)
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Method used to move the values of the Field1D to data, owned by a FieldArena
+// ---------------------------------------------------------------------------------------------------------------------
+void Field1D::relocate( double* data )
+{
+    memcpy( data, data_, globalDims_*sizeof(double) );
+    if (own_data_) delete [] data_;
+    data_ = data;
+    own_data_ = false;
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Method used to create a dump for a Field1D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -35,6 +35,8 @@ public:
     //! Method used to allocate a Field1D
     void allocateDims();
     void deallocateDims();
+    //! Move the values to data, not owned by the Field1D
+    void relocate( double* data );
     //! a Field1D can also be initialized win an unsigned int 
     void allocateDims(unsigned int dims1);
     //! 1D method used to allocate Field, isPrimal define if mainDim is Primal or Dual
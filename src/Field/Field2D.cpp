@@ -62,7 +62,7 @@ Field2D::~Field2D()
 {
 
     if (data_!=NULL) {
-        delete [] data_;
+        if (own_data_) delete [] data_;
         delete [] data_2D;
     }
 }
@@ -75,11 +75,12 @@ void Field2D::allocateDims()
 {
     //! \todo{Comment on what you are doing here (MG for JD)}
     if (dims_.size()!=2) ERROR("Alloc error must be 2 : " << dims_.size());
-    if (data_!=NULL) delete [] data_;
+    if (data_!=NULL && own_data_) delete [] data_;
 
     isDual_.resize( dims_.size(), 0 );
 
     data_ = new double[dims_[0]*dims_[1]];
+    own_data_ = true;
     //! \todo{check row major order!!! (JD)}
 
     data_2D= new double*[dims_[0]];
@@ -94,7 +95,7 @@ void Field2D::allocateDims()
 
 void Field2D::deallocateDims()
 {
-    delete [] data_;
+    if (own_data_) delete [] data_;
     data_ = NULL;
     delete [] data_2D;
     data_2D = NULL;
@@ -116,7 +117,7 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
 {
     //! \todo{Comment on what you are doing here (MG for JD)}
     if (dims_.size()!=2) ERROR("Alloc error must be 2 : " << dims_.size());
-    if (data_) delete [] data_;
+    if (data_ && own_data_) delete [] data_;
     
     // isPrimal define if mainDim is Primal or Dual
     isDual_.resize( dims_.size(), 0 );
@@ -131,6 +132,7 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
         dims_[j] += isDual_[j];
     
     data_ = new double[dims_[0]*dims_[1]];
+    own_data_ = true;
     //! \todo{check row major order!!! (JD)}
     
     data_2D= new double*[dims_[0]];
@@ -145,6 +147,21 @@ void Field2D::allocateDims(unsigned int mainDim, bool isPrimal )
 
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Method used to move the values of the Field2D to data, owned by a FieldArena
+// ---------------------------------------------------------------------------------------------------------------------
+void Field2D::relocate( double* data )
+{
+    memcpy( data, data_, globalDims_*sizeof(double) );
+    if (own_data_) delete [] data_;
+    data_ = data;
+    own_data_ = false;
+    
+    for (unsigned int i=0; i<dims_[0]; i++)
+        data_2D[i] = data_ + i*dims_[1];
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Method used to create a dump for a Field2D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -34,6 +34,8 @@ public:
     //! Method used to allocate a Field2D
     void allocateDims();
     void deallocateDims();
+    //! Move the values to data, not owned by the Field2D
+    void relocate( double* data );
     //! a Field2D can also be initialized win two unsigned int 
     void allocateDims(unsigned int dims1,unsigned int dims2);
     //! allocate dimensions for field2D isPrimal define if mainDim is Primal or Dual
@@ -61,7 +61,7 @@ Field3D::Field3D(string name, vector<unsigned int> dims) : Field(dims, name)
 Field3D::~Field3D()
 {
     if (data_!=NULL) {
-        delete [] data_;
+        if (own_data_) delete [] data_;
         for (unsigned int i=0; i<dims_[0]; i++) delete [] data_3D[i];
         delete [] data_3D;
     }
@@ -73,11 +73,12 @@ Field3D::~Field3D()
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::allocateDims() {
     if (dims_.size()!=3) ERROR("Alloc error must be 3 : " << dims_.size());
-    if (data_) delete [] data_;
+    if (data_ && own_data_) delete [] data_;
     
     isDual_.resize( dims_.size(), 0 );
     
     data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    own_data_ = true;
     //! \todo{check row major order!!!}
     data_3D= new double**[dims_[0]];
     for (unsigned int i=0; i<dims_[0]; i++)
@@ -97,7 +98,7 @@ void Field3D::allocateDims() {
 
 void Field3D::deallocateDims()
 {
-    delete [] data_;
+    if (own_data_) delete [] data_;
     data_ = NULL;
     for (unsigned int i=0; i<dims_[0]; i++) delete [] data_3D[i];
     delete [] data_3D;
@@ -121,7 +122,7 @@ void Field3D::allocateDims(unsigned int dims1, unsigned int dims2, unsigned int
 // ---------------------------------------------------------------------------------------------------------------------
 void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
     if (dims_.size()!=3) ERROR("Alloc error must be 3 : " << dims_.size());
-    if (data_) delete [] data_;
+    if (data_ && own_data_) delete [] data_;
     
     // isPrimal define if mainDim is Primal or Dual
     isDual_.resize( dims_.size(), 0 );
@@ -136,6 +137,7 @@ void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
         dims_[j] += isDual_[j];
     
     data_ = new double[dims_[0]*dims_[1]*dims_[2]];
+    own_data_ = true;
     //! \todo{check row major order!!!}
     data_3D= new double**[dims_[0]*dims_[1]];
     for (unsigned int i=0; i<dims_[0]; i++)
@@ -156,6 +158,22 @@ void Field3D::allocateDims(unsigned int mainDim, bool isPrimal ) {
 
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Method used to move the values of the Field3D to data, owned by a FieldArena
+// ---------------------------------------------------------------------------------------------------------------------
+void Field3D::relocate( double* data )
+{
+    memcpy( data, data_, globalDims_*sizeof(double) );
+    if (own_data_) delete [] data_;
+    data_ = data;
+    own_data_ = false;
+    
+    for (unsigned int i=0; i<dims_[0]; i++)
+        for (unsigned int j=0; j<dims_[1]; j++)
+            data_3D[i][j] = data_ + i*dims_[1]*dims_[2] + j*dims_[2];
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Method used to create a dump for a Field3D
 // ---------------------------------------------------------------------------------------------------------------------
@@ -35,6 +35,8 @@ public:
     //! Method used to allocate a Field3D
     void allocateDims();
     void deallocateDims();
+    //! Move the values to data, not owned by the Field3D
+    void relocate( double* data );
     //! a Field3D can also be initialized win three unsigned int 
     void allocateDims(unsigned int dims1,unsigned int dims2,unsigned int dims3);
     //! allocate dimensions for field3D isPrimal define if mainDim is Primal or Dual
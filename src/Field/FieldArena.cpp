@@ -0,0 +1,35 @@
+
+#include "FieldArena.h"
+
+#include <cstdlib>
+#include <cstring>
+
+#include "Field.h"
+#include "AlignedAllocator.h"
+
+using namespace std;
+
+FieldArena::FieldArena( vector<Field*> fields )
+{
+    // Size of each field rounded up to a multiple of the alignment
+    const size_t align = SMILEI_ALIGNMENT / sizeof(double);
+    offsets_.resize( fields.size()+1, 0 );
+    for (unsigned int i=0 ; i<fields.size() ; i++)
+        offsets_[i+1] = offsets_[i] + ( (fields[i]->globalDims_ + align - 1) / align ) * align;
+    
+    void* p = NULL;
+    if ( posix_memalign( &p, SMILEI_ALIGNMENT, offsets_.back()*sizeof(double) ) != 0 )
+        ERROR( "Cannot allocate the field arena (" << offsets_.back()*sizeof(double) << " bytes)" );
+    block_ = static_cast<double*>( p );
+    memset( block_, 0, offsets_.back()*sizeof(double) );
+    
+    for (unsigned int i=0 ; i<fields.size() ; i++)
+        fields[i]->relocate( block_ + offsets_[i] );
+    
+}
+
+
+FieldArena::~FieldArena()
+{
+    free( block_ );
+}
@@ -0,0 +1,34 @@
+#ifndef FIELDARENA_H
+#define FIELDARENA_H
+
+#include <vector>
+#include <cstddef>
+
+class Field;
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class FieldArena
+//!   Data of several fields of a patch in a single block aligned on SMILEI_ALIGNMENT bytes, instead of one array per
+//!   field : one allocation per patch, neighbor components close in memory, and consecutive fields sent in one message
+//!   The data of each field starts on an aligned address, the fields keep their layout (see Field::relocate)
+//  --------------------------------------------------------------------------------------------------------------------
+class FieldArena
+{
+public:
+    //! Move the data of the fields, already allocated, to the block, in the order of fields
+    FieldArena( std::vector<Field*> fields );
+    //! The fields must not be used after the destruction of their arena
+    ~FieldArena();
+    
+    //! Beginning of the block
+    inline double* data() { return block_; }
+    //! Offset (in doubles) of the data of field i in the block, the size of the block if i is the number of fields
+    inline std::size_t offset( unsigned int i ) { return offsets_[i]; }
+    
+private:
+    double* block_;
+    std::vector<std::size_t> offsets_;
+    
+};
+
+#endif
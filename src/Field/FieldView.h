@@ -0,0 +1,44 @@
+#ifndef FIELDVIEW_H
+#define FIELDVIEW_H
+
+#include "Field.h"
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Flat views of the fields for the solver loops : element (i,j) at data[i*ny+j], element (i,j,k) at
+//! data[(i*ny+j)*nz+k], instead of the row pointer tables of Field2D (data_2D) and Field3D (data_3D)
+//!   - the number of dimensions and the unit stride of the last direction are known at compile time : the inner loops
+//!     are vectorized with contiguous loads and stores, no gather of the rows
+//!   - the data and the strides are copied in the view, no reload of the field members in the loops
+//  --------------------------------------------------------------------------------------------------------------------
+class Field2DView
+{
+public:
+    Field2DView( Field* f ) : data_( f->data_ ), ny_( f->dims_[1] ) {}
+
+    inline double& operator() ( unsigned int i, unsigned int j ) const {
+        DEBUGEXEC(if (!std::isfinite(data_[i*ny_+j])) ERROR("Not finite "<< i << "," << j << " = " << data_[i*ny_+j]));
+        return data_[i*ny_+j];
+    }
+
+private:
+    double* const data_;
+    const unsigned int ny_;
+};
+
+
+class Field3DView
+{
+public:
+    Field3DView( Field* f ) : data_( f->data_ ), ny_( f->dims_[1] ), nz_( f->dims_[2] ) {}
+
+    inline double& operator() ( unsigned int i, unsigned int j, unsigned int k ) const {
+        DEBUGEXEC(if (!std::isfinite(data_[(i*ny_+j)*nz_+k])) ERROR("Not finite "<< i << "," << j << "," << k << " = " << data_[(i*ny_+j)*nz_+k]));
+        return data_[(i*ny_+j)*nz_+k];
+    }
+
+private:
+    double* const data_;
+    const unsigned int ny_, nz_;
+};
+
+#endif
@@ -152,20 +152,147 @@ void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 
 void Interpolator2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
-    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
-    
-    //Loop on bin particles
-    for (int ipart=istart ; ipart<iend; ipart++ ) {
-        //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
-        //Buffering of iol and delta
-        (*iold)[ipart*2] = ip_;
-        (*iold)[ipart*2+1] = jp_;
-        (*delta)[ipart*2] = deltax;
-        (*delta)[ipart*2+1] = deltay;
+    LocalFields* ELoc = &(smpi->dynamics_Epart[ithread][0]);
+    LocalFields* BLoc = &(smpi->dynamics_Bpart[ithread][0]);
+    int*    iold  = &(smpi->dynamics_iold[ithread][0]);
+    double* delta = &(smpi->dynamics_deltaold[ithread][0]);
+    
+    double* position_x = &( particles.position(0,0) );
+    double* position_y = &( particles.position(1,0) );
+    
+    // Positions relative to the nearest primal node, stored by the projector at the previous time step
+    double* cell_x   = particles.relative_positions ? particles.Cell  [0].data() : NULL;
+    double* cell_y   = particles.relative_positions ? particles.Cell  [1].data() : NULL;
+    double* offset_x = particles.relative_positions ? particles.Offset[0].data() : NULL;
+    double* offset_y = particles.relative_positions ? particles.Offset[1].data() : NULL;
+    
+    // Ex, Ey, Ez, Bx, By, Bz and their location along x and y (0: primal, 1: dual)
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    const int dual_x[6] = { 1, 0, 0, 0, 1, 1 };
+    const int dual_y[6] = { 0, 1, 0, 1, 0, 1 };
+    
+    // Coefficients and central indices of a block of particles, [primal/dual][stencil point][particle]
+    double coeffx[2][3][vecSize], coeffy[2][3][vecSize];
+    int    idx[2][vecSize], idy[2][vecSize];
+    double interp[6][vecSize];
+    double stencil[3][3];
+    
+    for ( int ivect=istart ; ivect<iend ; ivect+=vecSize ) {
+        int np = min( vecSize, iend-ivect );
+        
+        // The stored relative positions are used only if they are known for the whole block
+        bool relative = particles.relative_positions;
+        if ( relative ) {
+            for ( int ipart=0 ; ipart<np ; ipart++ )
+                relative = relative && ( cell_x[ivect+ipart] >= 0. );
+        }
+        
+        #pragma omp simd
+        for ( int ipart=0 ; ipart<np ; ipart++ ) {
+            int jpart = ivect+ipart;
+            
+            // Indexes of the central nodes (primal and dual) and distances to these nodes
+            double xp, xd, yp, yd, dxp, dxd, dyp, dyd;
+            if ( relative ) {
+                xp  = cell_x[jpart];
+                dxp = offset_x[jpart];
+                double sx = (double)( dxp >= 0. );
+                xd  = xp + sx;
+                dxd = dxp + 0.5 - sx;
+                
+                yp  = cell_y[jpart];
+                dyp = offset_y[jpart];
+                double sy = (double)( dyp >= 0. );
+                yd  = yp + sy;
+                dyd = dyp + 0.5 - sy;
+            } else {
+                // Normalized particle position
+                double xpn = position_x[jpart]*dx_inv_;
+                double ypn = position_y[jpart]*dy_inv_;
+                
+                xp  = round(xpn);
+                xd  = round(xpn+0.5);
+                yp  = round(ypn);
+                yd  = round(ypn+0.5);
+                dxp = xpn - xp;
+                dxd = xpn - xd + 0.5;
+                dyp = ypn - yp;
+                dyd = ypn - yd + 0.5;
+            }
+            
+            double delta2;
+            delta2 = dxd*dxd;
+            coeffx[1][0][ipart] = 0.5 * (delta2-dxd+0.25);
+            coeffx[1][1][ipart] = 0.75 - delta2;
+            coeffx[1][2][ipart] = 0.5 * (delta2+dxd+0.25);
+            
+            delta2 = dxp*dxp;
+            coeffx[0][0][ipart] = 0.5 * (delta2-dxp+0.25);
+            coeffx[0][1][ipart] = 0.75 - delta2;
+            coeffx[0][2][ipart] = 0.5 * (delta2+dxp+0.25);
+            
+            delta2 = dyd*dyd;
+            coeffy[1][0][ipart] = 0.5 * (delta2-dyd+0.25);
+            coeffy[1][1][ipart] = 0.75 - delta2;
+            coeffy[1][2][ipart] = 0.5 * (delta2+dyd+0.25);
+            
+            delta2 = dyp*dyp;
+            coeffy[0][0][ipart] = 0.5 * (delta2-dyp+0.25);
+            coeffy[0][1][ipart] = 0.75 - delta2;
+            coeffy[0][2][ipart] = 0.5 * (delta2+dyp+0.25);
+            
+            idx[0][ipart] = (int)xp - i_domain_begin;
+            idx[1][ipart] = (int)xd - i_domain_begin;
+            idy[0][ipart] = (int)yp - j_domain_begin;
+            idy[1][ipart] = (int)yd - j_domain_begin;
+            
+            //Buffering of iold and delta for the projection
+            iold [2*jpart  ] = idx[0][ipart];
+            iold [2*jpart+1] = idy[0][ipart];
+            delta[2*jpart  ] = dxp;
+            delta[2*jpart+1] = dyp;
+        }
+        
+        // Gather each component, the 3x3 field stencil is loaded once for consecutive particles sharing the same nodes
+        for ( int icomp=0 ; icomp<6 ; icomp++ ) {
+            int ix = dual_x[icomp];
+            int iy = dual_y[icomp];
+            double* f = fields[icomp]->data_;
+            int ny = fields[icomp]->dims_[1];
+            
+            int ip0 = 0;
+            while ( ip0<np ) {
+                int i0 = idx[ix][ip0];
+                int j0 = idy[iy][ip0];
+                int ip1 = ip0+1;
+                while ( ip1<np && idx[ix][ip1]==i0 && idy[iy][ip1]==j0 )
+                    ip1++;
+                
+                for ( int iloc=0 ; iloc<3 ; iloc++ )
+                    for ( int jloc=0 ; jloc<3 ; jloc++ )
+                        stencil[iloc][jloc] = f[ (i0+iloc-1)*ny + j0+jloc-1 ];
+                
+                #pragma omp simd
+                for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                    double interp_res = 0.;
+                    for ( int iloc=0 ; iloc<3 ; iloc++ )
+                        for ( int jloc=0 ; jloc<3 ; jloc++ )
+                            interp_res += coeffx[ix][iloc][ipart] * coeffy[iy][jloc][ipart] * stencil[iloc][jloc];
+                    interp[icomp][ipart] = interp_res;
+                }
+                ip0 = ip1;
+            }
+        }
+        
+        #pragma omp simd
+        for ( int ipart=0 ; ipart<np ; ipart++ ) {
+            ELoc[ivect+ipart].x = interp[0][ipart];
+            ELoc[ivect+ipart].y = interp[1][ipart];
+            ELoc[ivect+ipart].z = interp[2][ipart];
+            BLoc[ivect+ipart].x = interp[3][ipart];
+            BLoc[ivect+ipart].y = interp[4][ipart];
+            BLoc[ivect+ipart].z = interp[5][ipart];
+        }
     }
 
 }
@@ -32,6 +32,8 @@ public:
     };  
 
 private:
+    //! Number of particles whose coefficients are computed together in the bulk interpolation
+    static const int vecSize = 8;
     // Last prim index computed
     int ip_, jp_;
     // Last dual index computed
@@ -170,22 +170,134 @@ void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particl
 
 void Interpolator3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread)
 {
-    std::vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-    std::vector<LocalFields> *Bpart = &(smpi->dynamics_Bpart[ithread]);
-    std::vector<int> *iold = &(smpi->dynamics_iold[ithread]);
-    std::vector<double> *delta = &(smpi->dynamics_deltaold[ithread]);
-
-    //Loop on bin particles
-    for (int ipart=istart ; ipart<iend; ipart++ ) {
-        //Interpolation on current particle
-        (*this)(EMfields, particles, ipart, &(*Epart)[ipart], &(*Bpart)[ipart]);
-        //Buffering of iol and delta
-        (*iold)[ipart*3]    = ip_;
-        (*iold)[ipart*3+1]  = jp_;
-        (*iold)[ipart*3+2]  = kp_;
-        (*delta)[ipart*3]   = deltax;
-        (*delta)[ipart*3+1] = deltay;
-        (*delta)[ipart*3+2] = deltaz;
+    LocalFields* ELoc = &(smpi->dynamics_Epart[ithread][0]);
+    LocalFields* BLoc = &(smpi->dynamics_Bpart[ithread][0]);
+    int*    iold  = &(smpi->dynamics_iold[ithread][0]);
+    double* delta = &(smpi->dynamics_deltaold[ithread][0]);
+    
+    double* position[3];
+    for ( int idim=0 ; idim<3 ; idim++ )
+        position[idim] = &( particles.position(idim,0) );
+    double inv_cell[3] = { dx_inv_, dy_inv_, dz_inv_ };
+    int domain_begin[3] = { i_domain_begin, j_domain_begin, k_domain_begin };
+    
+    // Positions relative to the nearest primal node, stored by the projector at the previous time step
+    double* cell  [3] = { NULL, NULL, NULL };
+    double* offset[3] = { NULL, NULL, NULL };
+    if ( particles.relative_positions ) {
+        for ( int idim=0 ; idim<3 ; idim++ ) {
+            cell  [idim] = particles.Cell  [idim].data();
+            offset[idim] = particles.Offset[idim].data();
+        }
+    }
+    
+    // Ex, Ey, Ez, Bx, By, Bz and their location along x, y and z (0: primal, 1: dual)
+    Field* fields[6] = { EMfields->Ex_, EMfields->Ey_, EMfields->Ez_, EMfields->Bx_m, EMfields->By_m, EMfields->Bz_m };
+    const int dual[6][3] = { {1,0,0}, {0,1,0}, {0,0,1}, {0,1,1}, {1,0,1}, {1,1,0} };
+    
+    // Coefficients and central indices of a block of particles, [dimension][primal/dual][stencil point][particle]
+    double coeff[3][2][3][vecSize];
+    int    id[3][2][vecSize];
+    double interp[6][vecSize];
+    double stencil[3][3][3];
+    
+    for ( int ivect=istart ; ivect<iend ; ivect+=vecSize ) {
+        int np = min( vecSize, iend-ivect );
+        
+        // The stored relative positions are used only if they are known for the whole block
+        bool relative = particles.relative_positions;
+        if ( relative ) {
+            for ( int ipart=0 ; ipart<np ; ipart++ )
+                relative = relative && ( cell[0][ivect+ipart] >= 0. );
+        }
+        
+        for ( int idim=0 ; idim<3 ; idim++ ) {
+            #pragma omp simd
+            for ( int ipart=0 ; ipart<np ; ipart++ ) {
+                int jpart = ivect+ipart;
+                
+                // Indexes of the central nodes (primal and dual) and distances to these nodes
+                double xp, xd, dxp, dxd;
+                if ( relative ) {
+                    xp  = cell  [idim][jpart];
+                    dxp = offset[idim][jpart];
+                    double s = (double)( dxp >= 0. );
+                    xd  = xp + s;
+                    dxd = dxp + 0.5 - s;
+                } else {
+                    // Normalized particle position
+                    double xpn = position[idim][jpart]*inv_cell[idim];
+                    xp  = round(xpn);
+                    xd  = round(xpn+0.5);
+                    dxp = xpn - xp;
+                    dxd = xpn - xd + 0.5;
+                }
+                
+                double delta2;
+                delta2 = dxd*dxd;
+                coeff[idim][1][0][ipart] = 0.5 * (delta2-dxd+0.25);
+                coeff[idim][1][1][ipart] = 0.75 - delta2;
+                coeff[idim][1][2][ipart] = 0.5 * (delta2+dxd+0.25);
+                
+                delta2 = dxp*dxp;
+                coeff[idim][0][0][ipart] = 0.5 * (delta2-dxp+0.25);
+                coeff[idim][0][1][ipart] = 0.75 - delta2;
+                coeff[idim][0][2][ipart] = 0.5 * (delta2+dxp+0.25);
+                
+                id[idim][0][ipart] = (int)xp - domain_begin[idim];
+                id[idim][1][ipart] = (int)xd - domain_begin[idim];
+                
+                //Buffering of iold and delta for the projection
+                iold [3*jpart+idim] = id[idim][0][ipart];
+                delta[3*jpart+idim] = dxp;
+            }
+        }
+        
+        // Gather each component, the 3x3x3 field stencil is loaded once for consecutive particles sharing the same nodes
+        for ( int icomp=0 ; icomp<6 ; icomp++ ) {
+            int ix = dual[icomp][0];
+            int iy = dual[icomp][1];
+            int iz = dual[icomp][2];
+            double* f = fields[icomp]->data_;
+            int nz  = fields[icomp]->dims_[2];
+            int nyz = fields[icomp]->dims_[1]*nz;
+            
+            int ip0 = 0;
+            while ( ip0<np ) {
+                int i0 = id[0][ix][ip0];
+                int j0 = id[1][iy][ip0];
+                int k0 = id[2][iz][ip0];
+                int ip1 = ip0+1;
+                while ( ip1<np && id[0][ix][ip1]==i0 && id[1][iy][ip1]==j0 && id[2][iz][ip1]==k0 )
+                    ip1++;
+                
+                for ( int iloc=0 ; iloc<3 ; iloc++ )
+                    for ( int jloc=0 ; jloc<3 ; jloc++ )
+                        for ( int kloc=0 ; kloc<3 ; kloc++ )
+                            stencil[iloc][jloc][kloc] = f[ (i0+iloc-1)*nyz + (j0+jloc-1)*nz + k0+kloc-1 ];
+                
+                #pragma omp simd
+                for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                    double interp_res = 0.;
+                    for ( int iloc=0 ; iloc<3 ; iloc++ )
+                        for ( int jloc=0 ; jloc<3 ; jloc++ )
+                            for ( int kloc=0 ; kloc<3 ; kloc++ )
+                                interp_res += coeff[0][ix][iloc][ipart] * coeff[1][iy][jloc][ipart] * coeff[2][iz][kloc][ipart] * stencil[iloc][jloc][kloc];
+                    interp[icomp][ipart] = interp_res;
+                }
+                ip0 = ip1;
+            }
+        }
+        
+        #pragma omp simd
+        for ( int ipart=0 ; ipart<np ; ipart++ ) {
+            ELoc[ivect+ipart].x = interp[0][ipart];
+            ELoc[ivect+ipart].y = interp[1][ipart];
+            ELoc[ivect+ipart].z = interp[2][ipart];
+            BLoc[ivect+ipart].x = interp[3][ipart];
+            BLoc[ivect+ipart].y = interp[4][ipart];
+            BLoc[ivect+ipart].z = interp[5][ipart];
+        }
     }
 
 }
@@ -34,6 +34,8 @@ public:
     };  
 
 private:
+    //! Number of particles whose coefficients are computed together in the bulk interpolation
+    static const int vecSize = 8;
     // Last prim index computed
     int ip_, jp_, kp_;
     // Last dual index computed
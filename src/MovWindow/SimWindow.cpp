@@ -96,6 +96,9 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
     #pragma omp single
     {
     if (n_moved == 0) MESSAGE(">>> Window starts moving");
+    // Ghost layers still exchanged received before the patches move
+    if ( smpi->neighborhood() )
+        smpi->neighborhood()->completeAll();
     vecPatches_old.resize(nPatches);
     n_moved += params.n_space[0];
     }
@@ -148,6 +151,8 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
                 mypatch->tmp_MPI_neighbor_[idim][0] = vecPatches_old[mypatch->hindex - h0 ]->MPI_neighbor_[idim][0];
                 mypatch->tmp_MPI_neighbor_[idim][1] = vecPatches_old[mypatch->hindex - h0 ]->MPI_neighbor_[idim][1];
             }
+            mypatch->tmp_corner_neighbor_ = vecPatches_old[mypatch->hindex - h0 ]->corner_neighbor_;
+            mypatch->tmp_corner_MPI_neighbor_ = vecPatches_old[mypatch->hindex - h0 ]->corner_MPI_neighbor_;
             update_patches_.push_back(mypatch); // Stores pointers to patches that will need to update some neighbors from tmp_neighbors.
             
             //And finally put the patch at the correct rank in vecPatches.
@@ -208,7 +213,10 @@ void SimWindow::operate(VectorPatch& vecPatches, SmileiMPI* smpi, Params& params
             mypatch->neighbor_[idim][0] = mypatch->tmp_neighbor_[idim][0];
             mypatch->neighbor_[idim][1] = mypatch->tmp_neighbor_[idim][1];
         }
+        mypatch->corner_neighbor_ = mypatch->tmp_corner_neighbor_;
+        mypatch->corner_MPI_neighbor_ = mypatch->tmp_corner_MPI_neighbor_;
         mypatch->updateTagenv(smpi);
+        mypatch->updateSharedGhosts(smpi);
         if ( mypatch->isXmin() ){
             for (unsigned int ispec=0 ; ispec<nSpecies ; ispec++)
                 mypatch->vecSpecies[ispec]->setXminBoundaryCondition(); 
@@ -278,6 +278,26 @@ namelist("")
     if ( (Friedman_theta<0.) || (Friedman_theta>1.) )
         ERROR("Friedman filter = " << Friedman_theta << " needs to be in between 0 and 1");
     
+    // Spectral solver : local transforms on the patches, with psatd_guard_cells ghost cells at least, and derivatives
+    // of order psatd_order (psatd_order/2 points on each side)
+    psatd_guard_cells = 8;
+    PyTools::extract("psatd_guard_cells", psatd_guard_cells, "Main");
+    psatd_order = 8;
+    PyTools::extract("psatd_order", psatd_order, "Main");
+    if ( maxwell_sol == "PSATD" ) {
+#ifndef _FFTW
+        ERROR("maxwell_sol = 'PSATD' requires Smilei compiled with FFTW (make config=fftw)");
+#endif
+        if ( geometry == "1d3v" )
+            ERROR("maxwell_sol = 'PSATD' is available in 2d3v and 3d3v only");
+        if ( Friedman_filter )
+            ERROR("maxwell_sol = 'PSATD' cannot be used together with Friedman_filter");
+        if ( psatd_order<2 || psatd_order%2 )
+            ERROR("psatd_order = " << psatd_order << " must be even and at least 2");
+        if ( psatd_order/2 > psatd_guard_cells )
+            ERROR("psatd_order = " << psatd_order << " requires psatd_guard_cells >= " << psatd_order/2);
+    }
+    
     
     // testing the CFL condition
     //!\todo (MG) CFL cond. depends on the Maxwell solv. ==> HERE JUST DONE FOR YEE!!!
@@ -286,7 +306,8 @@ namelist("")
         res_space2 += res_space[i]*res_space[i];
     }
     dtCFL=1.0/sqrt(res_space2);
-    if ( timestep>dtCFL ) {
+    // No stability condition for the spectral solver
+    if ( timestep>dtCFL && maxwell_sol!="PSATD" ) {
         WARNING("CFL problem: timestep=" << timestep << " should be smaller than " << dtCFL);
     }
     
@@ -294,6 +315,59 @@ namelist("")
     
     // clrw 
     PyTools::extract("clrw",clrw, "Main");
+    
+    // currents projected in thread-private tiles, bin by bin
+    tiled_currents = false;
+    PyTools::extract("tiled_currents", tiled_currents, "Main");
+    
+    // patches split in OpenMP tasks when heavier than heavy_patch_factor times the mean patch
+    heavy_patch_factor = 0.;
+    PyTools::extract("heavy_patch_factor", heavy_patch_factor, "Main");
+    
+    // particles sent to a same MPI process gathered in one message
+    aggregate_particle_messages = false;
+    PyTools::extract("aggregate_particle_messages", aggregate_particle_messages, "Main");
+    
+    // particles exchanged with all neighbors, corners included, in a single round
+    single_round_particle_exchange = false;
+    PyTools::extract("single_round_particle_exchange", single_round_particle_exchange, "Main");
+    
+    // field ghost layers exchanged through a shared memory window between the processes of a node
+    shared_memory_ghosts = false;
+    PyTools::extract("shared_memory_ghosts", shared_memory_ghosts, "Main");
+    
+    // field ghost layers exchanged with persistent requests
+    persistent_requests = false;
+    PyTools::extract("persistent_requests", persistent_requests, "Main");
+    
+    // field ghost layers exchanged with neighborhood collectives
+    neighborhood_collectives = false;
+    PyTools::extract("neighborhood_collectives", neighborhood_collectives, "Main");
+    
+    // field components of a patch allocated in a single block
+    field_arena = false;
+    PyTools::extract("field_arena", field_arena, "Main");
+    
+    // Maxwell solver skipped in the patches without particles whose fields are all zero
+    skip_vacuum_patches = false;
+    PyTools::extract("skip_vacuum_patches", skip_vacuum_patches, "Main");
+    
+    // Temporal blocking : while the simulation contains no particle, ghost cells exchanged every temporal_blocking
+    // timesteps, with temporal_blocking-1 more ghost cells
+    temporal_blocking = 1;
+    PyTools::extract("temporal_blocking", temporal_blocking, "Main");
+    if ( temporal_blocking < 1 )
+        ERROR("temporal_blocking = " << temporal_blocking << " must be at least 1");
+    if ( temporal_blocking > 1 && maxwell_sol == "PSATD" )
+        ERROR("temporal_blocking cannot be used with maxwell_sol = 'PSATD'");
+    // Only the Silver-Muller conditions are applied inside the arrays, beyond the added ghost cells
+    if ( temporal_blocking > 1 ) {
+        vector<string>* bc_em_types[3] = { &bc_em_type_x, &bc_em_type_y, &bc_em_type_z };
+        for ( unsigned int i=0 ; i<3 ; i++ )
+            for ( unsigned int side=0 ; side<bc_em_types[i]->size() ; side++ )
+                if ( (*bc_em_types[i])[side] == "reflective" )
+                    ERROR("temporal_blocking cannot be used with reflective electromagnetic boundary conditions");
+    }
 
 
         
@@ -324,10 +398,16 @@ namelist("")
 #endif
     
     
+    coef_measured = 0.;
+    node_balancing_every = 0;
     if( PyTools::nComponents("LoadBalancing")>0 ) {
         PyTools::extract("every"      , balancing_every, "LoadBalancing");
+        PyTools::extract("node_every" , node_balancing_every, "LoadBalancing");
         PyTools::extract("coef_cell"  , coef_cell      , "LoadBalancing");
         PyTools::extract("coef_frozen", coef_frozen    , "LoadBalancing");
+        PyTools::extract("coef_measured", coef_measured, "LoadBalancing");
+        if ( coef_measured < 0. || coef_measured > 1. )
+            ERROR("LoadBalancing: coef_measured must be between 0 and 1");
         PyTools::extract("initial_balance", initial_balance    , "LoadBalancing");
     } else {
         balancing_every = 0;
@@ -418,6 +498,10 @@ void Params::compute()
     //n_space_global.resize(nDim_field, 0);
     for (unsigned int i=0; i<nDim_field; i++){
         oversize[i]  = interpolation_order + (exchange_particles_each-1);;
+        if ( maxwell_sol == "PSATD" && oversize[i] < psatd_guard_cells )
+            oversize[i] = psatd_guard_cells;
+        // The Yee solver invalidates one more ghost cell per timestep without exchange
+        oversize[i] += temporal_blocking - 1;
         n_space_global[i] = n_space[i];
         n_space[i] /= number_of_patches[i];
         if(n_space_global[i]%number_of_patches[i] !=0) ERROR("ERROR in dimension " << i <<". Number of patches = " << number_of_patches[i] << " must divide n_space_global = " << n_space_global[i]);
@@ -430,6 +514,20 @@ void Params::compute()
     // Verify that clrw divides n_space[0]
     if( n_space[0]%clrw != 0 )
         ERROR("The parameter clrw must divide the number of cells in one patch (in dimension x)");
+    
+    if( tiled_currents && ( (geometry!="2d3v" && geometry!="3d3v") || interpolation_order!=2 ) )
+        ERROR("tiled_currents is only available in 2d3v and 3d3v geometries, with interpolation_order = 2");
+    
+    if( heavy_patch_factor < 0. )
+        ERROR("heavy_patch_factor must be positive or zero");
+    if( tiled_currents && heavy_patch_factor > 0. )
+        WARNING("heavy_patch_factor is not used with tiled_currents, which already processes all patches bin by bin");
+    
+    if( single_round_particle_exchange && aggregate_particle_messages )
+        ERROR("single_round_particle_exchange and aggregate_particle_messages cannot be used together");
+    
+    if( neighborhood_collectives && ( shared_memory_ghosts || persistent_requests ) )
+        ERROR("neighborhood_collectives cannot be used together with shared_memory_ghosts or persistent_requests");
 
 }
 
@@ -485,8 +583,12 @@ void Params::print_init()
         MESSAGE(1,"Patches are initially homogeneously distributed between MPI ranks. (initial_balance = false) ");
         }
         MESSAGE(1,"Load balancing every " << balancing_every << " iterations.");
+        if (node_balancing_every > 0)
+            MESSAGE(1,"Load balancing inside the nodes every " << node_balancing_every << " iterations.");
         MESSAGE(1,"Cell load coefficient = " << coef_cell );
         MESSAGE(1,"Frozen particle load coefficient = " << coef_frozen );
+        if (coef_measured > 0.)
+            MESSAGE(1,"Weight of the measured particle load = " << coef_measured );
     }
 }
 
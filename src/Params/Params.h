@@ -126,6 +126,11 @@ public:
     //! Maxwell Solver (default='Yee')
     std::string maxwell_sol;
     
+    //! Minimum number of ghost cells with the spectral solver (maxwell_sol = "PSATD")
+    unsigned int psatd_guard_cells;
+    //! Order of the derivatives of the spectral solver (maxwell_sol = "PSATD")
+    unsigned int psatd_order;
+    
     //! Current spatial filter parameter: number of binomial pass
     unsigned int currentFilter_int;
     
@@ -138,6 +143,28 @@ public:
     //! Clusters width
     //unsigned int clrw;
     int clrw;
+    //! Bins of a same patch processed by different threads, with thread-private current tiles
+    bool tiled_currents;
+    //! Patches with more than heavy_patch_factor times the mean number of particles per patch are processed
+    //! bin by bin with OpenMP tasks (0 = never)
+    double heavy_patch_factor;
+    
+    //! Particles exchanged with another MPI process in a single message per direction, for all patches
+    bool aggregate_particle_messages;
+    //! Particles exchanged with all the neighbors (corners included) in a single round, instead of one per dimension
+    bool single_round_particle_exchange;
+    //! Field ghost layers exchanged through an MPI-3 shared memory window with the processes of the same node
+    bool shared_memory_ghosts;
+    //! Field ghost layers exchanged with persistent requests (MPI_Send_init/Recv_init), created again when the neighbors change
+    bool persistent_requests;
+    //! Field ghost layers exchanged with neighborhood collectives on a topology communicator of the MPI processes
+    bool neighborhood_collectives;
+    //! Main field components of a patch (E, B, B_m, J, rho) allocated in a single aligned block (see FieldArena)
+    bool field_arena;
+    //! Maxwell solver not applied to the patches without particles whose fields and currents are all zero
+    bool skip_vacuum_patches;
+    //! Number of timesteps between two exchanges of the ghost cells of the fields while there is no particle
+    unsigned int temporal_blocking;
     //! Number of cells per cluster
     int n_cell_per_patch;
     
@@ -186,10 +213,14 @@ public:
     std::vector<unsigned int> number_of_patches;
     //! Load balancing frequency
     int balancing_every;
+    //! Frequency of the load balancing inside each node only, between the global ones (0 = never)
+    int node_balancing_every;
     //! Load coefficient applied to a cell (default = 1)
     double coef_cell;
     //! Load coefficient applied to a frozen particle (default = 0.1)
     double coef_frozen;
+    //! Weight of the measured computing time of the particles in the load of a patch, vs their number (default = 0)
+    double coef_measured;
     //! Return if number of patch = number of MPI process, to tune IO //ism
     bool one_patch_per_MPI;
     //! Compute an initially balanced patch distribution right from the start
@@ -19,6 +19,7 @@
 
 #include "Patch.h"
 
+#include <algorithm>
 #include <cstdlib>
 #include <iostream>
 #include <iomanip>
@@ -91,10 +92,36 @@ void Patch::initStep1(Params& params)
         MPI_neighbor_[iDim].resize(2,MPI_PROC_NULL);
         tmp_MPI_neighbor_[iDim].resize(2,MPI_PROC_NULL);
     }
+    // 3^nDim_fields neighbors, computed by PatchXD::initStep2
+    int nCornerNeighbors = 1;
+    for ( int iDim = 0 ; iDim < nDim_fields_; iDim++ )
+        nCornerNeighbors *= 3;
+    corner_neighbor_.resize(nCornerNeighbors,MPI_PROC_NULL);
+    tmp_corner_neighbor_.resize(nCornerNeighbors,MPI_PROC_NULL);
+    corner_MPI_neighbor_.resize(nCornerNeighbors,MPI_PROC_NULL);
+    tmp_corner_MPI_neighbor_.resize(nCornerNeighbors,MPI_PROC_NULL);
+    
+    shm_send_.resize(nDim_fields_);
+    shm_recv_.resize(nDim_fields_);
+    shm_nsend_.resize(nDim_fields_);
+    shm_nrecv_.resize(nDim_fields_);
+    for ( int iDim = 0 ; iDim < nDim_fields_; iDim++ ) {
+        shm_send_[iDim].resize(2,NULL);
+        shm_recv_[iDim].resize(2,NULL);
+        shm_nsend_[iDim].resize(2,0);
+        shm_nrecv_[iDim].resize(2,0);
+    }
+    shm_slot_bytes_ = 0;
+    
+    persistent_requests_ = params.persistent_requests;
+    comm_epoch_ = 0;
+    neighborhood_ = NULL;
     
     oversize.resize( nDim_fields_ );
     for ( int iDim = 0 ; iDim < nDim_fields_; iDim++ )
         oversize[iDim] = params.oversize[iDim];
+    
+    measured_load = 0.;
 }
 
 
@@ -239,6 +266,9 @@ void Patch::updateTagenv(SmileiMPI* smpi)
             send_tags_[iDim][iNeighbor] = buildtag( hindex, iDim, iNeighbor, 5 );
             recv_tags_[iDim][iNeighbor] = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim, iNeighbor, 5 );
         }
+    
+    // Neighbors changed : persistent requests of the fields to create again
+    comm_epoch_++;
 }
 void Patch::updateMPIenv(SmileiMPI* smpi)
 {
@@ -248,16 +278,93 @@ void Patch::updateMPIenv(SmileiMPI* smpi)
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++){
             MPI_neighbor_[iDim][iNeighbor] = smpi->hrank(neighbor_[iDim][iNeighbor]);
         }
+    
+    for (unsigned int k=0 ; k<corner_neighbor_.size() ; k++)
+        corner_MPI_neighbor_[k] = smpi->hrank(corner_neighbor_[k]);
 
     for (int iDim=0 ; iDim< (int)neighbor_.size() ; iDim++)
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             send_tags_[iDim][iNeighbor] = buildtag( hindex, iDim, iNeighbor, 5 );
             recv_tags_[iDim][iNeighbor] = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim, iNeighbor, 5 );
         }
+    
+    updateSharedGhosts(smpi);
+    neighborhood_ = smpi->neighborhood();
+    
+    // Neighbors changed : persistent requests of the fields to create again
+    comm_epoch_++;
 
 } // END updateMPIenv
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Slots of the shared memory window used to exchange the ghost layers with the neighbors owned by another process
+// of the same node :
+//   - sent to neighbor iNeighbor : slots of the current patch for direction iNeighbor, in the segment of MPI_me_
+//   - received from neighbor iNeighbor : slots of the neighbor for the opposite direction, in its own segment
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::updateSharedGhosts(SmileiMPI* smpi)
+{
+    shm_slot_bytes_ = smpi->ghost_slot_bytes_;
+    
+    for (int iDim = 0 ; iDim < nDim_fields_ ; iDim++)
+        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+            shm_send_[iDim][iNeighbor] = NULL;
+            shm_recv_[iDim][iNeighbor] = NULL;
+            shm_nsend_[iDim][iNeighbor] = 0;
+            shm_nrecv_[iDim][iNeighbor] = 0;
+            if ( !smpi->sharedGhosts() || !is_a_MPI_neighbor( iDim, iNeighbor ) ) continue;
+            if ( smpi->nodeRank( MPI_neighbor_[iDim][iNeighbor] ) < 0 ) continue;
+            shm_send_[iDim][iNeighbor] = smpi->ghostSlot( MPI_me_, hindex, iDim, iNeighbor );
+            shm_recv_[iDim][iNeighbor] = smpi->ghostSlot( MPI_neighbor_[iDim][iNeighbor], neighbor_[iDim][iNeighbor], iDim, (iNeighbor+1)%2 );
+        }
+
+} // END updateSharedGhosts
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy in the next slot of the window the ghost layer described by ntype, to be read by the neighbor iNeighbor
+// Layers are read in the same order as they are packed, as MPI messages are matched in the order they are sent
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::packSharedGhost( void* start, MPI_Datatype ntype, int iDim, int iNeighbor )
+{
+    if ( shm_nsend_[iDim][iNeighbor] == SMILEI_GHOST_MSGS )
+        ERROR( "More than " << SMILEI_GHOST_MSGS << " ghost layers per direction in an exchange through the shared memory" );
+    
+    char* slot = shm_send_[iDim][iNeighbor] + shm_nsend_[iDim][iNeighbor] * shm_slot_bytes_;
+    shm_nsend_[iDim][iNeighbor]++;
+    
+    int position(0);
+    MPI_Pack( start, 1, ntype, slot, shm_slot_bytes_, &position, MPI_COMM_WORLD );
+
+} // END packSharedGhost
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Copy in the ghost cells described by ntype the next ghost layer packed by the neighbor iNeighbor
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::unpackSharedGhost( void* start, MPI_Datatype ntype, int iDim, int iNeighbor )
+{
+    char* slot = shm_recv_[iDim][iNeighbor] + shm_nrecv_[iDim][iNeighbor] * shm_slot_bytes_;
+    shm_nrecv_[iDim][iNeighbor]++;
+    
+    int position(0);
+    MPI_Unpack( slot, shm_slot_bytes_, &position, start, 1, ntype, MPI_COMM_WORLD );
+
+} // END unpackSharedGhost
+
+
+void Patch::resetSharedGhosts()
+{
+    for (int iDim = 0 ; iDim < nDim_fields_ ; iDim++)
+        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+            shm_nsend_[iDim][iNeighbor] = 0;
+            shm_nrecv_[iDim][iNeighbor] = 0;
+        }
+
+} // END resetSharedGhosts
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Split particles Id to send in per direction and per patch neighbor dedicated buffers
 // Apply periodicity if necessary
@@ -273,7 +380,6 @@ void Patch::initExchParticles(SmileiMPI* smpi, int ispec, Params& params)
     for (int iDim=0 ; iDim < ndim ; iDim++){
         for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
             vecSpecies[ispec]->MPIbuff.partRecv[iDim][iNeighbor].clear();//resize(0,ndim);
-            vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor].clear();//resize(0,ndim);
             vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
         }
@@ -330,7 +436,9 @@ void Patch::initCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iD
 
             if (is_a_MPI_neighbor(iDim, iNeighbor)) {
                 //If neighbour is MPI ==> I send him the number of particles I'll send later.
+                //(unless particles are aggregated per MPI process: the numbers are then sent with them)
                 int tag = buildtag( hindex, iDim+1, iNeighbor+3 );
+                if (!params.aggregate_particle_messages)
                       MPI_Isend( &(vecSpecies[ispec]->MPIbuff.part_index_send_sz[iDim][iNeighbor]), 1, MPI_INT, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
             }
             else {
@@ -339,7 +447,7 @@ void Patch::initCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iD
             }
         } // END of Send
 
-        if (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) {
+        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && !params.aggregate_particle_messages ) {
             if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
                 //If other neighbour is MPI ==> I receive the number of particles I'll receive later.
                 int tag = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim+1, iNeighbor+3 );
@@ -355,6 +463,9 @@ void Patch::initCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iD
 // For direction iDim, finalize receive of number of particles and really send particles
 //   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
 //   - smpi     : used smpi->periods_
+// The particles are packed in a byte buffer kept from one step to the next, one message per patch, species and
+// direction : the messages of all the species of all the patches are gathered per process with
+// aggregate_particle_messages (SyncVectorPatch::finalize_and_sort_parts_per_rank)
 // ---------------------------------------------------------------------------------------------------------------------
 void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch * vecPatch)
 {
@@ -367,7 +478,7 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
     /********************************************************************************/
     // Wait for end of communications over number of particles
     /********************************************************************************/
-    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ && !params.aggregate_particle_messages ; iNeighbor++) {
         MPI_Status sstat    [2];
         MPI_Status rstat    [2];
         if (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) {
@@ -399,22 +510,23 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
             if (smpi->periods_[iDim]==1) {
                 for (int iPart=0 ; iPart<n_part_send ; iPart++) {
                     if ( ( iNeighbor==0 ) &&  (Pcoordinates[iDim] == 0 ) &&( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) < 0. ) ) {
-                        cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     += x_max;
+                        cuParticles.shiftPosition( iDim, vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart],  x_max,  params.n_space_global[iDim] );
                     }
                     else if ( ( iNeighbor==1 ) &&  (Pcoordinates[iDim] == params.number_of_patches[iDim]-1 ) && ( cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart]) >= x_max ) ) {
-                        cuParticles.position(iDim,vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart])     -= x_max;
+                        cuParticles.shiftPosition( iDim, vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart], -x_max, -(int)params.n_space_global[iDim] );
                     }
                 }
             }
             // Send particles
             if (is_a_MPI_neighbor(iDim, iNeighbor)) {
-                // If MPI comm, first copy particles in the sendbuffer
-                for (int iPart=0 ; iPart<n_part_send ; iPart++) 
-                    cuParticles.cp_particle(vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor][iPart], vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]);
-                // Then send particles
+                // If MPI comm, first pack particles in the send buffer
+                std::vector<char> &bufferSend = vecSpecies[ispec]->MPIbuff.bufferSend[iDim][iNeighbor];
+                bufferSend.clear();
+                cuParticles.pack( bufferSend, vecSpecies[ispec]->MPIbuff.part_index_send[iDim][iNeighbor] );
+                // Then send particles, unless they are aggregated per MPI process (SyncVectorPatch::exchangeParticlesPerRank)
                 int tag = buildtag( hindex, iDim+1, iNeighbor+3 );
-                vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]) );
-                MPI_Isend( &((vecSpecies[ispec]->MPIbuff.partSend[iDim][iNeighbor]).position(0,0)), 1, vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
+                if (!params.aggregate_particle_messages)
+                    MPI_Isend( &bufferSend[0], bufferSend.size(), MPI_BYTE, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]) );
             }
             else {
                 //If not MPI comm, copy particles directly in the receive buffer
@@ -424,12 +536,13 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
         } // END of Send
                 
         n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2];
-        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
+        if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) && !params.aggregate_particle_messages ) {
             if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                // If MPI comm, receive particles in the recv buffer previously initialized.
-                vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor] = smpi->createMPIparticles( &(vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]) );
+                // If MPI comm, receive packed particles, unpacked in the recv buffer once arrived
+                std::vector<char> &bufferRecv = vecSpecies[ispec]->MPIbuff.bufferRecv[iDim][(iNeighbor+1)%2];
+                bufferRecv.resize( n_part_recv * cuParticles.packedSize() );
                 int tag = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim+1 ,iNeighbor+3 );
-                MPI_Irecv( &((vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).position(0,0)), 1, vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor], MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+                MPI_Irecv( &bufferRecv[0], bufferRecv.size(), MPI_BYTE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
             }
 
         } // END of Recv
@@ -441,8 +554,7 @@ void Patch::CommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim,
 
 // ---------------------------------------------------------------------------------------------------------------------
 // For direction iDim, finalize receive of particles, temporary store particles if diagonalParticles
-// And store recv particles at their definitive place. 
-// Call Patch::cleanup_sent_particles
+// And store recv particles at their definitive place while removing the sent ones (Particles::erase_and_insert)
 //   - vecPatch : used for intra-MPI process comm (direct copy using Particels::cp_particles)
 //   - smpi     : used smpi->periods_
 // ---------------------------------------------------------------------------------------------------------------------
@@ -454,20 +566,13 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
 
     Particles &cuParticles = (*vecSpecies[ispec]->particles);
     
-    std::vector<int>* indexes_of_particles_to_exchange = &vecSpecies[ispec]->indexes_of_particles_to_exchange;
-    
-    std::vector<int>* cubmin = &vecSpecies[ispec]->bmin;
     std::vector<int>* cubmax = &vecSpecies[ispec]->bmax;
     
-    int nmove,lmove,ii; // local, OK
-    int shift[(*cubmax).size()+1];//how much we need to shift each bin in order to leave room for the new particle
+    int ii; // local, OK
     double dbin;
     
     dbin = params.cell_length[0]*params.clrw; //width of a bin.
-    for (unsigned int j=0; j<(*cubmax).size()+1 ;j++){
-        shift[j]=0;
-    }
-    int n_part_send, n_part_recv, n_particles;
+    int n_part_send, n_part_recv;
 
     /********************************************************************************/
     // Wait for end of communications over Particles
@@ -482,19 +587,21 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
 
  
         if ( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (n_part_send!=0) ) {
-            if (is_a_MPI_neighbor(iDim, iNeighbor)) {
+            if (is_a_MPI_neighbor(iDim, iNeighbor) && !params.aggregate_particle_messages) {
                 MPI_Wait( &(vecSpecies[ispec]->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iNeighbor]) );
-                MPI_Type_free( &(vecSpecies[ispec]->typePartSend[(iDim*2)+iNeighbor]) );
             }
         }
         if ( (neighbor_[iDim][(iNeighbor+1)%2]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
             if (is_a_MPI_neighbor(iDim, (iNeighbor+1)%2)) {
-                MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );     
-                MPI_Type_free( &(vecSpecies[ispec]->typePartRecv[(iDim*2)+iNeighbor]) );
+                if (!params.aggregate_particle_messages)
+                    MPI_Wait( &(vecSpecies[ispec]->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[(iNeighbor+1)%2]) );     
+                vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2].unpack( &(vecSpecies[ispec]->MPIbuff.bufferRecv[iDim][(iNeighbor+1)%2][0]), n_part_recv );
             }
 
             // Treat diagonalParticles
             if (iDim < ndim-1){ // No need to treat diag particles at last dimension.
+                // Indexes of the diagonal particles, removed from the receive buffer all at once
+                std::vector<int> diag_indexes;
                 for (int iPart=n_part_recv-1 ; iPart>=0; iPart-- ) {
                     check = 0;
                     idim = iDim+1;//We check next dimension
@@ -512,7 +619,7 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
                                 vecSpecies[ispec]->addPartInExchList(cuParticles.size()-1);
                             }
                             //Remove it from receive buffer.
-                            (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).erase_particle(iPart);
+                            diag_indexes.push_back(iPart);
                             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]--;
                             check = 1;
                         }
@@ -524,13 +631,15 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
                                 vecSpecies[ispec]->MPIbuff.part_index_send[idim][1].push_back( cuParticles.size()-1 );
                                 vecSpecies[ispec]->addPartInExchList(cuParticles.size()-1);
                             }
-                            (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).erase_particle(iPart);
+                            diag_indexes.push_back(iPart);
                             vecSpecies[ispec]->MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2]--;
                             check = 1;
                         }
                         idim++;
                     }
                 }
+                std::reverse(diag_indexes.begin(), diag_indexes.end());
+                (vecSpecies[ispec]->MPIbuff.partRecv[iDim][(iNeighbor+1)%2]).erase_particles(diag_indexes);
             }//If not last dim for diagonal particles.
 
         } //If received something
@@ -538,83 +647,274 @@ void Patch::finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, in
 
     //La recopie finale doit se faire au traitement de la dernière dimension seulement !!
     if (iDim == ndim-1){
-   
-        //We have stored in indexes_of_particles_to_exchange the list of all particles that needs to be removed.
-        cleanup_sent_particles(ispec, indexes_of_particles_to_exchange);
-        (*indexes_of_particles_to_exchange).clear();
-        cuParticles.erase_particle_trail((*cubmax).back());
-
-        //Evaluation of the necessary shift of all bins.
-        for (unsigned int j=0; j<(*cubmax).size()+1 ;j++){
-            shift[j]=0;
-        }
-
-        //idim=0
-        shift[1] += vecSpecies[ispec]->MPIbuff.part_index_recv_sz[0][0];//Particles coming from ymin all go to bin 0 and shift all the other bins.
-        shift[(*cubmax).size()] += vecSpecies[ispec]->MPIbuff.part_index_recv_sz[0][1];//Used only to count the total number of particles arrived.
-        //idim>0
-        for (idim = 1; idim < ndim; idim++){
+        
+        unsigned int nbin = (*cubmax).size();
+        
+        // Gather the particles received from all directions, each one goes at the end of its bin
+        Particles recvParticles;
+        recvParticles.initialize(0, cuParticles);
+        std::vector<int> recv_bins;
+        for (idim = 0; idim < ndim; idim++){
             for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
                 n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[idim][iNeighbor];
-                for (unsigned int j=0; j<(unsigned int)n_part_recv ;j++){
-                    //We first evaluate how many particles arrive in each bin.
-                        ii = int((vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_local[0])/dbin);//bin in which the particle goes.
-                    shift[ii+1]++; // It makes the next bins shift.
+                if ( (neighbor_[idim][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
+                    Particles &partRecv = vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor];
+                    partRecv.cp_particles(0, n_part_recv, recvParticles, recvParticles.size());
+                    for(int j=0; j<n_part_recv; j++){
+                        if (idim == 0)
+                            ii = iNeighbor*(nbin-1);//0 if iNeighbor=0(particles coming from Xmin) and nbin-1 otherwise.
+                        else
+                            ii = int((partRecv.position(0,j)-min_local[0])/dbin);//bin in which the particle goes.
+                        recv_bins.push_back( ii );
+                    }
                 }
             }
         }
+        
+        insertReceivedParticles(ispec, recvParticles, recv_bins);
 
+    }//End Recv_buffers ==> particles
 
-        //Must be done sequentially
-        for (unsigned int j=1; j<(*cubmax).size()+1;j++){ //bin 0 is not shifted.Last element of shift stores total number of arriving particles.
-            shift[j]+=shift[j-1];
-        }
-        //Make room for new particles
-        if (shift[(*cubmax).size()]) {
-          //! vecor::resize of Charge crashed ! Temporay solution : push_back / Particle
-          //cuParticles.initialize( cuParticles.size()+shift[(*cubmax).size()], cuParticles.Position.size() );
-          for (int inewpart=0 ; inewpart<shift[(*cubmax).size()] ; inewpart++) cuParticles.create_particle();
+
+} // finalizeCommParticles(... iDim)
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Remove the sent particles (Species::indexes_of_particles_to_exchange) and insert the received ones at the end of
+// their bin (recv_bins), in a single pass (Particles::erase_and_insert), then update the bin bounds
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::insertReceivedParticles(int ispec, Particles& recvParticles, std::vector<int>& recv_bins)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    std::vector<int>* indexes_of_particles_to_exchange = &vecSpecies[ispec]->indexes_of_particles_to_exchange;
+    std::vector<int>* cubmin = &vecSpecies[ispec]->bmin;
+    std::vector<int>* cubmax = &vecSpecies[ispec]->bmax;
+    
+    unsigned int nbin = (*cubmax).size();
+    
+    std::vector<int> insert_before( recv_bins.size() );
+    std::vector<int> nrecv_per_bin(nbin, 0);
+    for (unsigned int j=0; j<recv_bins.size(); j++){
+        insert_before[j] = (*cubmax)[recv_bins[j]];
+        nrecv_per_bin[recv_bins[j]]++;
+    }
+    
+    //We have stored in indexes_of_particles_to_exchange the list of all particles that needs to be removed.
+    std::vector<int> nsent_per_bin(nbin, 0);
+    unsigned int ibin = 0;
+    for (unsigned int k=0; k<(*indexes_of_particles_to_exchange).size(); k++){
+        int iPart = (*indexes_of_particles_to_exchange)[k];
+        while (ibin < nbin-1 && iPart >= (*cubmax)[ibin]) ibin++;
+        if (iPart < (*cubmax)[ibin]) nsent_per_bin[ibin]++;
+    }
+    
+    // Remove the sent particles and insert the received ones in a single pass
+    // Ordered by bin too : an empty bin and the previous one share the same insert position
+    cuParticles.erase_and_insert(*indexes_of_particles_to_exchange, recvParticles, insert_before, recv_bins);
+    (*indexes_of_particles_to_exchange).clear();
+    
+    // New bin bounds
+    int n_particles_bin;
+    for (ibin=0; ibin<nbin; ibin++){
+        n_particles_bin = (*cubmax)[ibin]-(*cubmin)[ibin] - nsent_per_bin[ibin] + nrecv_per_bin[ibin];
+        if (ibin>0) (*cubmin)[ibin] = (*cubmax)[ibin-1];
+        (*cubmax)[ibin] = (*cubmin)[ibin] + n_particles_bin;
+    }
+    cuParticles.erase_particle_trail((*cubmax).back());
+
+} // END insertReceivedParticles
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Single round exchange (single_round_particle_exchange) : split particles Id to send per neighbor, the neighbor
+// being the patch the particle enters, which can share only an edge or a corner with the current patch
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initExchParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    int ndim = params.nDim_field;
+    std::vector<int>* indexes_of_particles_to_exchange = &vecSpecies[ispec]->indexes_of_particles_to_exchange;
+    int nk = corner_neighbor_.size();
+    
+    for (int k=0 ; k<nk ; k++) {
+        MPIbuff.partRecv_corner[k].clear();
+        MPIbuff.part_index_send_corner[k].resize(0);
+        MPIbuff.part_index_recv_sz_corner[k] = 0;
+    }
+    
+    for (unsigned int i=0 ; i<(*indexes_of_particles_to_exchange).size() ; i++) {
+        int iPart = (*indexes_of_particles_to_exchange)[i];
+        // Offsets of the destination patch in all dimensions give its place in corner_neighbor_
+        int k(0), stride(1);
+        for (int idim=0 ; idim<ndim ; idim++) {
+            int offset = 0;
+            if ( cuParticles.position(idim,iPart) < min_local[idim] )
+                offset = -1;
+            else if ( cuParticles.position(idim,iPart) >= max_local[idim] )
+                offset = 1;
+            k += (offset+1)*stride;
+            stride *= 3;
         }
-            
-        //Shift bins, must be done sequentially
-        for (unsigned int j=(*cubmax).size()-1; j>=1; j--){
-            n_particles = (*cubmax)[j]-(*cubmin)[j]; //Nbr of particle in this bin
-            nmove = min(n_particles,shift[j]); //Nbr of particles to move
-            lmove = max(n_particles,shift[j]); //How far particles must be shifted
-            if (nmove>0) cuParticles.overwrite_part((*cubmin)[j], (*cubmin)[j]+lmove, nmove);
-            (*cubmin)[j] += shift[j];
-            (*cubmax)[j] += shift[j];
+        //If particle is outside of the global domain (has no neighbor), it will not be put in a send buffer and will simply be deleted.
+        if ( (k != nk/2) && (corner_neighbor_[k]!=MPI_PROC_NULL) )
+            MPIbuff.part_index_send_corner[k].push_back( iPart );
+    }
+
+} // initExchParticlesSingleRound
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Single round exchange : start exchange of number of particles with all neighbors
+// Particles sent towards k are received by the neighbor from its opposite direction nk-1-k
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::initCommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    int h0 = (*vecPatch)(0)->hindex;
+    int nk = corner_neighbor_.size();
+    
+    for (int k=0 ; k<nk ; k++) {
+        if ( (k == nk/2) || (corner_neighbor_[k]==MPI_PROC_NULL) ) continue;
+        
+        MPIbuff.part_index_send_sz_corner[k] = MPIbuff.part_index_send_corner[k].size();
+        if (is_a_MPI_corner_neighbor(k)) {
+            //If neighbour is MPI ==> I send him the number of particles I'll send later and receive the number of particles he'll send.
+            MPI_Isend( &(MPIbuff.part_index_send_sz_corner[k]), 1, MPI_INT, corner_MPI_neighbor_[k], hindex*64+k, smpi->SMILEI_COMM_PARTICLES, &(MPIbuff.srequest_corner[k]) );
+            MPI_Irecv( &(MPIbuff.part_index_recv_sz_corner[k]), 1, MPI_INT, corner_MPI_neighbor_[k], corner_neighbor_[k]*64+nk-1-k, smpi->SMILEI_COMM_PARTICLES, &(MPIbuff.rrequest_corner[k]) );
         }
-            
-        //Space has been made now to write the arriving particles into the correct bins
-        //idim == 0  is the easy case, when particles arrive either in first or last bin.
-        for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-            n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[0][iNeighbor];
-            if ( (neighbor_[0][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-                ii = iNeighbor*((*cubmax).size()-1);//0 if iNeighbor=0(particles coming from Xmin) and (*cubmax).size()-1 otherwise.
-                vecSpecies[ispec]->MPIbuff.partRecv[0][iNeighbor].overwrite_part(0, cuParticles,(*cubmax)[ii],n_part_recv);
-                (*cubmax)[ii] += n_part_recv ;
-            }
+        else {
+            //Else, I directly set the receive size to the correct value.
+            (*vecPatch)( corner_neighbor_[k]- h0 )->vecSpecies[ispec]->MPIbuff.part_index_recv_sz_corner[nk-1-k] = MPIbuff.part_index_send_sz_corner[k];
         }
-        //idim > 0; this is the difficult case, when particles can arrive in any bin.
-        for (idim = 1; idim < ndim; idim++){
-            //if (idim!=iDim) continue;
-            for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-                n_part_recv = vecSpecies[ispec]->MPIbuff.part_index_recv_sz[idim][iNeighbor];
-                if ( (neighbor_[idim][iNeighbor]!=MPI_PROC_NULL) && (n_part_recv!=0) ) {
-                        for(unsigned int j=0; j<(unsigned int)n_part_recv; j++){
-                            ii = int((vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].position(0,j)-min_local[0])/dbin);//bin in which the particle goes.
-                            vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].overwrite_part(j, cuParticles,(*cubmax)[ii]);
-                            (*cubmax)[ii] ++ ;
-                        }
+    }
+
+} // initCommParticlesSingleRound
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Single round exchange : finalize receive of number of particles and really send particles to all neighbors
+// Periodicity is applied in all the dimensions crossed by the particles
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::CommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    int ndim = params.nDim_field;
+    int h0 = (*vecPatch)(0)->hindex;
+    int nk = corner_neighbor_.size();
+    MPI_Status status;
+    
+    /********************************************************************************/
+    // Wait for end of communications over number of particles
+    /********************************************************************************/
+    for (int k=0 ; k<nk ; k++) {
+        if ( (k == nk/2) || !is_a_MPI_corner_neighbor(k) ) continue;
+        MPI_Wait( &(MPIbuff.srequest_corner[k]), &status );
+        MPI_Wait( &(MPIbuff.rrequest_corner[k]), &status );
+        if (MPIbuff.part_index_recv_sz_corner[k]!=0)
+            MPIbuff.partRecv_corner[k].initialize( MPIbuff.part_index_recv_sz_corner[k], cuParticles );
+    }
+    
+    /********************************************************************************/
+    // Proceed to effective Particles' communications
+    /********************************************************************************/
+    for (int k=0 ; k<nk ; k++) {
+        if ( (k == nk/2) || (corner_neighbor_[k]==MPI_PROC_NULL) ) continue;
+        
+        std::vector<int> &part_index_send = MPIbuff.part_index_send_corner[k];
+        int n_part_send = part_index_send.size();
+        if (n_part_send!=0) {
+            // Enabled periodicity, in each dimension crossed towards this neighbor
+            for (int idim=0, stride=1 ; idim<ndim ; idim++, stride*=3) {
+                int offset = (k/stride)%3 - 1;
+                if ( (offset==0) || (smpi->periods_[idim]!=1) ) continue;
+                double x_max = params.cell_length[idim]*( params.n_space_global[idim] );
+                if ( (offset==-1) && (Pcoordinates[idim] == 0) ) {
+                    for (int iPart=0 ; iPart<n_part_send ; iPart++)
+                        if ( cuParticles.position(idim,part_index_send[iPart]) < 0. )
+                            cuParticles.shiftPosition( idim, part_index_send[iPart],  x_max,  params.n_space_global[idim] );
+                }
+                else if ( (offset==1) && (Pcoordinates[idim] == params.number_of_patches[idim]-1) ) {
+                    for (int iPart=0 ; iPart<n_part_send ; iPart++)
+                        if ( cuParticles.position(idim,part_index_send[iPart]) >= x_max )
+                            cuParticles.shiftPosition( idim, part_index_send[iPart], -x_max, -(int)params.n_space_global[idim] );
                 }
             }
-        }
+            // Send particles
+            if (is_a_MPI_corner_neighbor(k)) {
+                std::vector<char> &bufferSend = MPIbuff.bufferSend_corner[k];
+                bufferSend.clear();
+                cuParticles.pack( bufferSend, part_index_send );
+                MPI_Isend( &bufferSend[0], bufferSend.size(), MPI_BYTE, corner_MPI_neighbor_[k], hindex*64+32+k, smpi->SMILEI_COMM_PARTICLES, &(MPIbuff.srequest_corner[k]) );
+            }
+            else {
+                //If not MPI comm, copy particles directly in the receive buffer
+                Particles &partRecv = (*vecPatch)( corner_neighbor_[k]- h0 )->vecSpecies[ispec]->MPIbuff.partRecv_corner[nk-1-k];
+                for (int iPart=0 ; iPart<n_part_send ; iPart++)
+                    cuParticles.cp_particle( part_index_send[iPart], partRecv );
+            }
+        } // END of Send
+        
+        int n_part_recv = MPIbuff.part_index_recv_sz_corner[k];
+        if ( (n_part_recv!=0) && is_a_MPI_corner_neighbor(k) ) {
+            // Receive packed particles, unpacked in the recv buffer once arrived
+            std::vector<char> &bufferRecv = MPIbuff.bufferRecv_corner[k];
+            bufferRecv.resize( n_part_recv * cuParticles.packedSize() );
+            MPI_Irecv( &bufferRecv[0], bufferRecv.size(), MPI_BYTE, corner_MPI_neighbor_[k], corner_neighbor_[k]*64+32+nk-1-k, smpi->SMILEI_COMM_PARTICLES, &(MPIbuff.rrequest_corner[k]) );
+        } // END of Recv
+    }
 
-    }//End Recv_buffers ==> particles
+} // END CommParticlesSingleRound
 
 
-} // finalizeCommParticles(... iDim)
+// ---------------------------------------------------------------------------------------------------------------------
+// Single round exchange : finalize receive of particles from all neighbors, and store them at their definitive place
+// while removing the sent ones. No particle needs to be forwarded.
+// ---------------------------------------------------------------------------------------------------------------------
+void Patch::finalizeCommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch * vecPatch)
+{
+    Particles &cuParticles = (*vecSpecies[ispec]->particles);
+    SpeciesMPIbuffers &MPIbuff = vecSpecies[ispec]->MPIbuff;
+    int nk = corner_neighbor_.size();
+    int nbin = vecSpecies[ispec]->bmax.size();
+    double dbin = params.cell_length[0]*params.clrw; //width of a bin.
+    MPI_Status status;
+    
+    Particles recvParticles;
+    recvParticles.initialize(0, cuParticles);
+    std::vector<int> recv_bins;
+    
+    for (int k=0 ; k<nk ; k++) {
+        if ( (k == nk/2) || (corner_neighbor_[k]==MPI_PROC_NULL) ) continue;
+        
+        if ( is_a_MPI_corner_neighbor(k) ) {
+            if (MPIbuff.part_index_send_corner[k].size()!=0)
+                MPI_Wait( &(MPIbuff.srequest_corner[k]), &status );
+            if (MPIbuff.part_index_recv_sz_corner[k]!=0) {
+                MPI_Wait( &(MPIbuff.rrequest_corner[k]), &status );
+                MPIbuff.partRecv_corner[k].unpack( &(MPIbuff.bufferRecv_corner[k][0]), MPIbuff.part_index_recv_sz_corner[k] );
+            }
+        }
+        
+        // Gather the particles received from all neighbors, each one goes at the end of its bin
+        int n_part_recv = MPIbuff.part_index_recv_sz_corner[k];
+        if (n_part_recv==0) continue;
+        Particles &partRecv = MPIbuff.partRecv_corner[k];
+        partRecv.cp_particles(0, n_part_recv, recvParticles, recvParticles.size());
+        for (int j=0; j<n_part_recv; j++) {
+            if (k%3 == 0)
+                recv_bins.push_back( 0 );      // coming from Xmin
+            else if (k%3 == 2)
+                recv_bins.push_back( nbin-1 ); // coming from Xmax
+            else
+                recv_bins.push_back( min( max( int((partRecv.position(0,j)-min_local[0])/dbin), 0 ), nbin-1 ) );
+        }
+    }
+    
+    insertReceivedParticles(ispec, recvParticles, recv_bins);
+
+} // END finalizeCommParticlesSingleRound
 
 
 void Patch::cleanParticlesOverhead(Params& params)
@@ -627,71 +927,34 @@ void Patch::cleanParticlesOverhead(Params& params)
             for ( int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++ ) {
                 vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].clear();
                 vecSpecies[ispec]->MPIbuff.partRecv[idim][iNeighbor].shrink_to_fit(ndim);
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].clear();
-                vecSpecies[ispec]->MPIbuff.partSend[idim][iNeighbor].shrink_to_fit(ndim);
+                vector<char>().swap(vecSpecies[ispec]->MPIbuff.bufferSend[idim][iNeighbor]);
+                vector<char>().swap(vecSpecies[ispec]->MPIbuff.bufferRecv[idim][iNeighbor]);
                 vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor].clear();
                 vector<int>(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]).swap(vecSpecies[ispec]->MPIbuff.part_index_send[idim][iNeighbor]);
             }
         }
+        for (unsigned int k=0 ; k<corner_neighbor_.size() ; k++) {
+            vecSpecies[ispec]->MPIbuff.partRecv_corner[k].clear();
+            vecSpecies[ispec]->MPIbuff.partRecv_corner[k].shrink_to_fit(ndim);
+            vector<char>().swap(vecSpecies[ispec]->MPIbuff.bufferSend_corner[k]);
+            vector<char>().swap(vecSpecies[ispec]->MPIbuff.bufferRecv_corner[k]);
+            vector<int>().swap(vecSpecies[ispec]->MPIbuff.part_index_send_corner[k]);
+        }
 
         cuParticles.shrink_to_fit(ndim);
     }
 
 }
 
-// ---------------------------------------------------------------------------------------------------------------------
-// Clear vecSpecies[]->indexes_of_particles_to_exchange, suppress particles send and manage memory
-// ---------------------------------------------------------------------------------------------------------------------
-void Patch::cleanup_sent_particles(int ispec, std::vector<int>* indexes_of_particles_to_exchange)
-{
-    /********************************************************************************/
-    // Delete Particles included in the index of particles to exchange. Assumes indexes are sorted.
-    /********************************************************************************/
-    int ii, iPart;
-    std::vector<int>* cubmin = &vecSpecies[ispec]->bmin;
-    std::vector<int>* cubmax = &vecSpecies[ispec]->bmax;
-    Particles &cuParticles = (*vecSpecies[ispec]->particles);
 
-    
-    // Push lost particles at the end of bins
-    for (unsigned int ibin = 0 ; ibin < (*cubmax).size() ; ibin++ ) {
-        ii = (*indexes_of_particles_to_exchange).size()-1;
-        if (ii >= 0) { // Push lost particles to the end of the bin
-            iPart = (*indexes_of_particles_to_exchange)[ii];
-            while (iPart >= (*cubmax)[ibin] && ii > 0) {
-                ii--;
-                iPart = (*indexes_of_particles_to_exchange)[ii];
-            }
-            while (iPart == (*cubmax)[ibin]-1 && iPart >= (*cubmin)[ibin] && ii > 0) {
-                (*cubmax)[ibin]--;
-                ii--;
-                iPart = (*indexes_of_particles_to_exchange)[ii];
-            }
-            while (iPart >= (*cubmin)[ibin] && ii > 0) {
-                cuParticles.overwrite_part((*cubmax)[ibin]-1, iPart );
-                (*cubmax)[ibin]--;
-                ii--;
-                iPart = (*indexes_of_particles_to_exchange)[ii];
-            }
-            if (iPart >= (*cubmin)[ibin] && iPart < (*cubmax)[ibin]) { //On traite la dernière particule (qui peut aussi etre la premiere)
-                cuParticles.overwrite_part((*cubmax)[ibin]-1, iPart );
-                (*cubmax)[ibin]--;
-            }
-        }
-    }
-
-
-    //Shift the bins in memory
-    //Warning: this loop must be executed sequentially. Do not use openMP here.
-    for (int unsigned ibin = 1 ; ibin < (*cubmax).size() ; ibin++ ) { //First bin don't need to be shifted
-        ii = (*cubmin)[ibin]-(*cubmax)[ibin-1]; // Shift the bin in memory by ii slots.
-        iPart = min(ii,(*cubmax)[ibin]-(*cubmin)[ibin]); // Number of particles we have to shift = min (Nshift, Nparticle in the bin)
-        if(iPart > 0) cuParticles.overwrite_part((*cubmax)[ibin]-iPart,(*cubmax)[ibin-1],iPart);
-        (*cubmax)[ibin] -= ii;
-        (*cubmin)[ibin] = (*cubmax)[ibin-1];
-    }
+bool Patch::noParticles()
+{
+    for (unsigned int ispec=0 ; ispec<vecSpecies.size() ; ispec++)
+        if ( vecSpecies[ispec]->getNbrOfParticles() > 0 )
+            return false;
+    return true;
+}
 
-} // END cleanup_sent_particles
 
 void Patch::testSumField( Field* field, int iDim )
 {
@@ -16,6 +16,7 @@
 class Collisions;
 class Diagnostic;
 class SimWindow;
+class NeighborhoodExchange;
 
 //! Class Patch :
 //!   - data container
@@ -97,8 +98,18 @@ public:
     void finalizeCommParticles(SmileiMPI* smpi, int ispec, Params& params, int iDim, VectorPatch* vecPatch);
     //! clean memory resizing particles structure
     void cleanParticlesOverhead(Params& params);
-    //! delete Particles included in the index of particles to exchange. Assumes indexes are sorted.
-    void cleanup_sent_particles(int ispec, std::vector<int>* indexes_of_particles_to_exchange);
+    //! true if no species has particles in the patch
+    bool noParticles();
+    
+    // Single round exchange of particles with all the neighbors, corners included (single_round_particle_exchange)
+    //! manage Idx of particles per neighbor (faces, edges and corners)
+    void initExchParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params);
+    //! init comm / nbr of particles with all neighbors
+    void initCommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
+    //! finalize comm / nbr of particles, init exch / particles with all neighbors
+    void CommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
+    //! finalize exch / particles, manage particles suppr/introduce
+    void finalizeCommParticlesSingleRound(SmileiMPI* smpi, int ispec, Params& params, VectorPatch* vecPatch);
     
     //! init comm / sum densities
     virtual void initSumField( Field* field, int iDim ) = 0;
@@ -117,6 +128,16 @@ public:
     //! finalize comm / exchange fields in direction iDim only
     virtual void finalizeExchange( Field* field, int iDim ) = 0;
     
+    // Ghost layers exchanged through the shared memory window with the patches of the same node (shared_memory_ghosts)
+    //! Compute the slots of the window used with the neighbors owned by another process of the node
+    void updateSharedGhosts(SmileiMPI* smpi);
+    //! Pack the ghost layer sent to neighbor iNeighbor (replaces MPI_Isend)
+    void packSharedGhost( void* start, MPI_Datatype ntype, int iDim, int iNeighbor );
+    //! Unpack the ghost layer received from neighbor iNeighbor (replaces MPI_Irecv), once the window synchronized
+    void unpackSharedGhost( void* start, MPI_Datatype ntype, int iDim, int iNeighbor );
+    //! Reset the slot counters, at the end of an exchange
+    void resetSharedGhosts();
+    
     // Create MPI_Datatype to exchange fields
     virtual void createType( Params& params ) = 0;
     virtual void cleanType() = 0;
@@ -161,6 +182,26 @@ public:
     return( (neighbor_[iDim][iNeighbor]!=MPI_PROC_NULL) && (MPI_neighbor_[iDim][iNeighbor]!=MPI_me_) );
     }
     
+    // Test if the MPI neighbor is on the same node, ghost layers exchanged through the shared memory window
+    inline bool is_a_node_neighbor(int iDim, int iNeighbor) {
+    return( shm_send_[iDim][iNeighbor]!=NULL );
+    }
+    
+    //! Epoch of the neighborhood used to create the persistent requests of the fields, -1 if not used (MPI_Isend/Irecv)
+    inline int requestsEpoch() {
+    return( persistent_requests_ ? comm_epoch_ : -1 );
+    }
+    
+    //! Neighborhood collective of the MPI process used for the ghost layers, NULL if point-to-point messages
+    inline NeighborhoodExchange* neighborhood() {
+    return( neighborhood_ );
+    }
+    
+    // Test who is MPI neighbor of current patch, among all neighbors (see corner_neighbor_)
+    inline bool is_a_MPI_corner_neighbor(int k) {
+    return( (corner_neighbor_[k]!=MPI_PROC_NULL) && (corner_MPI_neighbor_[k]!=MPI_me_) );
+    }
+    
     inline bool has_an_MPI_neighbor() {
         for ( unsigned int iDim=0 ; iDim<MPI_neighbor_.size() ; iDim++ ) {
             if ( ( MPI_neighbor_[iDim][0] != MPI_me_ ) &&  ( MPI_neighbor_[iDim][0]!= MPI_PROC_NULL ) )
@@ -252,6 +293,18 @@ public:
 
     std::vector<MPI_Request> requests_;
     
+    //! Packed particles of all species, sent in a single message when the patch moves to another process
+    std::vector<char> exchangeBuffer;
+    
+    //! Wall-clock time spent on the particles (pusher, projection, ionization) and the collisions of the patch
+    //! since the last load balancing
+    double measured_load;
+    //! Accumulate measured_load, from any thread
+    inline void addMeasuredLoad(double time) {
+        #pragma omp atomic
+        measured_load += time;
+    }
+    
 
     
 protected:
@@ -272,6 +325,32 @@ protected:
     
     //! MPI rank of neighbors patch
     std::vector< std::vector<int> > MPI_neighbor_, tmp_MPI_neighbor_;
+    
+    //! Hilbert index of the 3^nDim patches around (faces, edges and corners), the patch itself in the middle
+    //!   - neighbor at offsets (ox, oy, oz) in {-1, 0, 1} stored at k = (ox+1) + 3*(oy+1) + 9*(oz+1)
+    //!   - the opposite direction of k is 3^nDim-1-k
+    std::vector<int> corner_neighbor_, tmp_corner_neighbor_;
+    //! MPI rank of the patches of corner_neighbor_
+    std::vector<int> corner_MPI_neighbor_, tmp_corner_MPI_neighbor_;
+    
+    //! Slots of the shared memory window for the ghost layers sent to / received from the neighbors of the node
+    //! (NULL if the neighbor is not owned by another process of the node)
+    std::vector< std::vector<char*> > shm_send_, shm_recv_;
+    //! Number of ghost layers sent to / received from each neighbor through the window in the current exchange
+    std::vector< std::vector<int> > shm_nsend_, shm_nrecv_;
+    //! Size in bytes of a slot of the window
+    int shm_slot_bytes_;
+    
+    //! Field ghost layers exchanged with persistent requests (Params::persistent_requests)
+    bool persistent_requests_;
+    //! Incremented each time the neighbors change (updateMPIenv, updateTagenv), the persistent requests being outdated
+    int comm_epoch_;
+    
+    //! Neighborhood collective of the MPI process (SmileiMPI::neighborhood)
+    NeighborhoodExchange* neighborhood_;
+    
+    //! Insert in the bins the received particles, while removing the sent ones (Species::indexes_of_particles_to_exchange)
+    void insertReceivedParticles(int ispec, Particles& recvParticles, std::vector<int>& recv_bins);
 
     //! "Real" min limit of local sub-subdomain (ghost data not concerned)
     //!     - "0." on rank 0
@@ -55,6 +55,11 @@ void Patch1D::initStep2(Params& params)
     if (params.bc_em_type_x[0]=="periodic" && xcall >= (1<<params.mi[0])) xcall -= (1<<params.mi[0]);
     neighbor_[0][1] = generalhilbertindex( params.mi[0], params.mi[1], xcall, ycall);
     
+    // All neighbors (see Patch::corner_neighbor_)
+    corner_neighbor_[0] = neighbor_[0][0];
+    corner_neighbor_[1] = hindex;
+    corner_neighbor_[2] = neighbor_[0][1];
+    
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         ntype_[0][ix_isPrim] = MPI_DATATYPE_NULL;
         ntype_[1][ix_isPrim] = MPI_DATATYPE_NULL;
@@ -91,6 +96,7 @@ void Patch1D::initSumField( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( sumRequests, iDim, this );
     
     std::vector<unsigned int> n_elem = field->dims_;
     std::vector<unsigned int> isDual = field->isDual_;
@@ -115,13 +121,13 @@ void Patch1D::initSumField( Field* field, int iDim )
             istart = iNeighbor * ( n_elem[iDim]- oversize2[iDim] ) + (1-iNeighbor) * ( 0 );
             ix = (1-iDim)*istart;
             int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
+            f1D->MPIbuff.isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
         } // END of Send
             
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             int tmp_elem = f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
             int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            f1D->MPIbuff.irecv( &( f1D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
         } // END of Recv
             
     } // END for iNeighbor
@@ -272,6 +278,7 @@ void Patch1D::initExchange( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( exchangeRequests, iDim, this );
 
     std::vector<unsigned int> n_elem   = field->dims_;
     std::vector<unsigned int> isDual = field->isDual_;
@@ -287,16 +294,19 @@ void Patch1D::initExchange( Field* field, int iDim )
             istart = iNeighbor * ( n_elem[iDim]- (2*oversize[iDim]+1+isDual[iDim]) ) + (1-iNeighbor) * ( oversize[iDim] + 1 + isDual[iDim] );
             ix = (1-iDim)*istart;
             int tag = f1D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.srequest[iDim][iNeighbor]) );
+            if ( is_a_node_neighbor( iDim, iNeighbor ) )
+                packSharedGhost( &(f1D->data_[ix]), ntype, iDim, iNeighbor );
+            else
+                f1D->MPIbuff.isend( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
 
         } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
             istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1 - (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
             ix = (1-iDim)*istart;
             int tag = f1D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+            f1D->MPIbuff.irecv( &(f1D->data_[ix]), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
 
         } // END of Recv
 
@@ -317,14 +327,26 @@ void Patch1D::finalizeExchange( Field* field, int iDim )
     MPI_Status rstat    [nDim_fields_][2];
 
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) && !is_a_node_neighbor( iDim, iNeighbor ) ) {
             MPI_Wait( &(f1D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             MPI_Wait( &(f1D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
 
+    // Ghost layers packed by the neighbors of the node in the shared memory window (SyncVectorPatch::syncSharedGhosts)
+    std::vector<unsigned int> n_elem = field->dims_;
+    std::vector<unsigned int> isDual = field->isDual_;
+    MPI_Datatype ntype = ntype_[iDim][isDual[0]];
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_node_neighbor( iDim, iNeighbor ) ) {
+            int istart = iNeighbor * ( n_elem[iDim] - 1 - (oversize[iDim]-1) );
+            int ix = (1-iDim)*istart;
+            unpackSharedGhost( &(f1D->data_[ix]), ntype, iDim, iNeighbor );
+        }
+    }
+
 } // END finalizeExchange( Field* field, int iDim )
 
 
@@ -65,6 +65,17 @@ void Patch2D::initStep2(Params& params)
     ycall = Pcoordinates[1]+1;
     if (params.bc_em_type_y[0]=="periodic" && ycall >= (1<<params.mi[1])) ycall -= (1<<params.mi[1]);
     neighbor_[1][1] = generalhilbertindex( params.mi[0], params.mi[1], xcall, ycall);
+    
+    // All neighbors, corners included (see Patch::corner_neighbor_)
+    for (int oy=-1 ; oy<=1 ; oy++) {
+        for (int ox=-1 ; ox<=1 ; ox++) {
+            xcall = Pcoordinates[0]+ox;
+            ycall = Pcoordinates[1]+oy;
+            if (params.bc_em_type_x[0]=="periodic") xcall = (xcall + (1<<params.mi[0])) % (1<<params.mi[0]);
+            if (params.bc_em_type_y[0]=="periodic") ycall = (ycall + (1<<params.mi[1])) % (1<<params.mi[1]);
+            corner_neighbor_[ (ox+1) + 3*(oy+1) ] = generalhilbertindex( params.mi[0], params.mi[1], xcall, ycall);
+        }
+    }
 
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         for (int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++) {
@@ -107,6 +118,7 @@ void Patch2D::initSumField( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( sumRequests, iDim, this );
 
 //    int patch_ndims_(2);
     int patch_nbNeighbors_(2);
@@ -142,7 +154,7 @@ void Patch2D::initSumField( Field* field, int iDim )
             int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
             //int tag = buildtag( hindex, iDim, iNeighbor, tagp );
             //cout << hindex << " send to " << neighbor_[iDim][iNeighbor] << endl;
-            MPI_Isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
+            f2D->MPIbuff.isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
         } // END of Send
             
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
@@ -150,7 +162,7 @@ void Patch2D::initSumField( Field* field, int iDim )
             //int tag = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim, iNeighbor, tagp );
             int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
             //cout << hindex << " recv from " << neighbor_[iDim][(iNeighbor+1)%2] << " ; n_elements = " << tmp_elem << endl;
-            MPI_Irecv( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            f2D->MPIbuff.irecv( &( f2D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0]) , tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
 
         } // END of Recv
             
@@ -331,6 +343,7 @@ void Patch2D::initExchange( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( exchangeRequests, iDim, this );
 
     int patch_nbNeighbors_(2);
     
@@ -351,18 +364,21 @@ void Patch2D::initExchange( Field* field, int iDim )
             iy =    iDim *istart;
             int tag = f2D->MPIbuff.send_tags_[iDim][iNeighbor];
             //int tag = buildtag( hindex, iDim, iNeighbor, tagp );
-            MPI_Isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.srequest[iDim][iNeighbor]) );
+            if ( is_a_node_neighbor( iDim, iNeighbor ) )
+                packSharedGhost( &((*f2D)(ix,iy)), ntype, iDim, iNeighbor );
+            else
+                f2D->MPIbuff.isend( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
 
         } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
             istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
             ix = (1-iDim)*istart;
             iy =    iDim *istart;
             int tag = f2D->MPIbuff.recv_tags_[iDim][iNeighbor];
             //int tag = buildtag( neighbor_[iDim][(iNeighbor+1)%2], iDim, iNeighbor, tagp );
-            MPI_Irecv( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, MPI_COMM_WORLD, &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+            f2D->MPIbuff.irecv( &((*f2D)(ix,iy)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
 
         } // END of Recv
 
@@ -386,14 +402,27 @@ void Patch2D::finalizeExchange( Field* field, int iDim )
     MPI_Status rstat    [patch_ndims_][2];
 
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) && !is_a_node_neighbor( iDim, iNeighbor ) ) {
             MPI_Wait( &(f2D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             MPI_Wait( &(f2D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
 
+    // Ghost layers packed by the neighbors of the node in the shared memory window (SyncVectorPatch::syncSharedGhosts)
+    std::vector<unsigned int> n_elem = field->dims_;
+    std::vector<unsigned int> isDual = field->isDual_;
+    MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]];
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_node_neighbor( iDim, iNeighbor ) ) {
+            int istart = iNeighbor * ( n_elem[iDim] - 1 - (oversize[iDim]-1) );
+            int ix = (1-iDim)*istart;
+            int iy =    iDim *istart;
+            unpackSharedGhost( &((*f2D)(ix,iy)), ntype, iDim, iNeighbor );
+        }
+    }
+
 } // END finalizeExchange( Field* field, int iDim )
 
 
@@ -85,6 +85,21 @@ void Patch3D::initStep2(Params& params)
     zcall = Pcoordinates[2]+1;
     if (params.bc_em_type_z[0]=="periodic" && zcall >= (1<<params.mi[2])) zcall -= (1<<params.mi[2]);
     neighbor_[2][1] =  generalhilbertindex( params.mi[0], params.mi[1], params.mi[2], xcall, ycall, zcall);
+    
+    // All neighbors, edges and corners included (see Patch::corner_neighbor_)
+    for (int oz=-1 ; oz<=1 ; oz++) {
+        for (int oy=-1 ; oy<=1 ; oy++) {
+            for (int ox=-1 ; ox<=1 ; ox++) {
+                xcall = Pcoordinates[0]+ox;
+                ycall = Pcoordinates[1]+oy;
+                zcall = Pcoordinates[2]+oz;
+                if (params.bc_em_type_x[0]=="periodic") xcall = (xcall + (1<<params.mi[0])) % (1<<params.mi[0]);
+                if (params.bc_em_type_y[0]=="periodic") ycall = (ycall + (1<<params.mi[1])) % (1<<params.mi[1]);
+                if (params.bc_em_type_z[0]=="periodic") zcall = (zcall + (1<<params.mi[2])) % (1<<params.mi[2]);
+                corner_neighbor_[ (ox+1) + 3*(oy+1) + 9*(oz+1) ] = generalhilbertindex( params.mi[0], params.mi[1], params.mi[2], xcall, ycall, zcall);
+            }
+        }
+    }
 
     for (int ix_isPrim=0 ; ix_isPrim<2 ; ix_isPrim++) {
         for (int iy_isPrim=0 ; iy_isPrim<2 ; iy_isPrim++) {
@@ -130,6 +145,7 @@ void Patch3D::initSumField( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( sumRequests, iDim, this );
 
     int patch_ndims_(3);
     int patch_nbNeighbors_(2);
@@ -173,15 +189,13 @@ void Patch3D::initSumField( Field* field, int iDim )
             iy = idx[1]*istart;
             iz = idx[2]*istart;
             int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
+            f3D->MPIbuff.isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
         } // END of Send
             
         if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             int tmp_elem = f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2].size();
             int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]) );
+            f3D->MPIbuff.irecv( &( f3D->MPIbuff.buf[iDim][(iNeighbor+1)%2][0] ), tmp_elem, MPI_DOUBLE, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
         } // END of Recv
             
     } // END for iNeighbor
@@ -372,6 +386,7 @@ void Patch3D::initExchange( Field* field, int iDim )
 
         field->MPIbuff.defineTags( this, tagp );
     }
+    field->MPIbuff.initRequests( exchangeRequests, iDim, this );
 
     int patch_ndims_(3);
     int patch_nbNeighbors_(2);
@@ -395,20 +410,21 @@ void Patch3D::initExchange( Field* field, int iDim )
             iy = idx[1]*istart;
             iz = idx[2]*istart;
             int tag = f3D->MPIbuff.send_tags_[iDim][iNeighbor];
-            MPI_Isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.srequest[iDim][iNeighbor]) );
+            if ( is_a_node_neighbor( iDim, iNeighbor ) )
+                packSharedGhost( &((*f3D)(ix,iy,iz)), ntype, iDim, iNeighbor );
+            else
+                f3D->MPIbuff.isend( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][iNeighbor], tag, iDim, iNeighbor );
 
         } // END of Send
 
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
 
             istart = ( (iNeighbor+1)%2 ) * ( n_elem[iDim] - 1- (oversize[iDim]-1) ) + (1-(iNeighbor+1)%2) * ( 0 )  ;
             ix = idx[0]*istart;
             iy = idx[1]*istart;
             iz = idx[2]*istart;
             int tag = f3D->MPIbuff.recv_tags_[iDim][iNeighbor];
-            MPI_Irecv( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, 
-                       MPI_COMM_WORLD, &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]));
+            f3D->MPIbuff.irecv( &((*f3D)(ix,iy,iz)), 1, ntype, MPI_neighbor_[iDim][(iNeighbor+1)%2], tag, iDim, (iNeighbor+1)%2 );
 
         } // END of Recv
 
@@ -432,14 +448,30 @@ void Patch3D::finalizeExchange( Field* field, int iDim )
     MPI_Status rstat    [patch_ndims_][2];
 
     for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
-        if ( is_a_MPI_neighbor( iDim, iNeighbor ) ) {
+        if ( is_a_MPI_neighbor( iDim, iNeighbor ) && !is_a_node_neighbor( iDim, iNeighbor ) ) {
             MPI_Wait( &(f3D->MPIbuff.srequest[iDim][iNeighbor]), &(sstat[iDim][iNeighbor]) );
         }
-        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) ) {
+        if ( is_a_MPI_neighbor( iDim, (iNeighbor+1)%2 ) && !is_a_node_neighbor( iDim, (iNeighbor+1)%2 ) ) {
             MPI_Wait( &(f3D->MPIbuff.rrequest[iDim][(iNeighbor+1)%2]), &(rstat[iDim][(iNeighbor+1)%2]) );
         }
     }
 
+    // Ghost layers packed by the neighbors of the node in the shared memory window (SyncVectorPatch::syncSharedGhosts)
+    std::vector<unsigned int> n_elem = field->dims_;
+    std::vector<unsigned int> isDual = field->isDual_;
+    vector<int> idx( patch_ndims_,0 );
+    idx[iDim] = 1;
+    MPI_Datatype ntype = ntype_[iDim][isDual[0]][isDual[1]][isDual[2]];
+    for (int iNeighbor=0 ; iNeighbor<nbNeighbors_ ; iNeighbor++) {
+        if ( is_a_node_neighbor( iDim, iNeighbor ) ) {
+            int istart = iNeighbor * ( n_elem[iDim] - 1 - (oversize[iDim]-1) );
+            int ix = idx[0]*istart;
+            int iy = idx[1]*istart;
+            int iz = idx[2]*istart;
+            unpackSharedGhost( &((*f3D)(ix,iy,iz)), ntype, iDim, iNeighbor );
+        }
+    }
+
 } // END finalizeExchange( Field* field, int iDim )
 
 
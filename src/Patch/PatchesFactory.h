@@ -49,6 +49,9 @@ public:
         }
         DEBUG( smpi->getRank() << ", nPatch = " << npatches << " - starting at " << firstpatch );
         
+        // Shared memory window for the ghost layers, needed by the patches to compute their slots
+        smpi->allocateGhostWindow( params );
+        
         // Create patches (create patch#0 then clone it)
         vecPatches.resize(npatches);
         vecPatches.patches_[0] = create(params, smpi, firstpatch, n_moved);
@@ -65,6 +68,9 @@ public:
         }
         MESSAGE(1,"All patches created");
         
+        // Topology communicator of the processes owning the neighbor patches
+        smpi->createNeighborhood( vecPatches );
+        
         vecPatches.set_refHindex();
         
         vecPatches.update_field_list();
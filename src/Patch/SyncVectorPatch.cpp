@@ -2,6 +2,9 @@
 #include "SyncVectorPatch.h"
 
 #include <vector>
+#include <map>
+#include <set>
+#include <cstring>
 
 #include "VectorPatch.h"
 #include "Params.h"
@@ -11,6 +14,19 @@ using namespace std;
 
 void SyncVectorPatch::exchangeParticles(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
 {
+    // Single round with all neighbors, corners included
+    if (params.single_round_particle_exchange) {
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            vecPatches(ipatch)->initExchParticlesSingleRound(smpi, ispec, params);
+        }
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            vecPatches(ipatch)->initCommParticlesSingleRound(smpi, ispec, params, &vecPatches);
+        }
+        return;
+    }
+    
     #pragma omp for schedule(runtime)
     for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
         vecPatches(ipatch)->initExchParticles(smpi, ispec, params);
@@ -41,29 +57,41 @@ void SyncVectorPatch::exchangeParticles(VectorPatch& vecPatches, int ispec, Para
 
 void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
 {
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->CommParticles(smpi, ispec, params, 0, &vecPatches);
-    }
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-        vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, 0, &vecPatches);
-    }
-    
-    // Per direction
-    for (unsigned int iDim=1 ; iDim<params.nDim_particle ; iDim++) {
+    if (params.single_round_particle_exchange) {
         #pragma omp for schedule(runtime)
         for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-            vecPatches(ipatch)->initCommParticles(smpi, ispec, params, iDim, &vecPatches);
+            vecPatches(ipatch)->CommParticlesSingleRound(smpi, ispec, params, &vecPatches);
         }
-        
         #pragma omp for schedule(runtime)
         for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-            vecPatches(ipatch)->CommParticles(smpi, ispec, params, iDim, &vecPatches);
+            vecPatches(ipatch)->finalizeCommParticlesSingleRound(smpi, ispec, params, &vecPatches);
+        }
+    }
+    else {
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            vecPatches(ipatch)->CommParticles(smpi, ispec, params, 0, &vecPatches);
         }
         #pragma omp for schedule(runtime)
         for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
-            vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, iDim, &vecPatches);
+            vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, 0, &vecPatches);
+        }
+    
+        // Per direction
+        for (unsigned int iDim=1 ; iDim<params.nDim_particle ; iDim++) {
+            #pragma omp for schedule(runtime)
+            for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+                vecPatches(ipatch)->initCommParticles(smpi, ispec, params, iDim, &vecPatches);
+            }
+        
+            #pragma omp for schedule(runtime)
+            for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+                vecPatches(ipatch)->CommParticles(smpi, ispec, params, iDim, &vecPatches);
+            }
+            #pragma omp for schedule(runtime)
+            for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+                vecPatches(ipatch)->finalizeCommParticles(smpi, ispec, params, iDim, &vecPatches);
+            }
         }
     }
     
@@ -73,11 +101,159 @@ void SyncVectorPatch::finalize_and_sort_parts(VectorPatch& vecPatches, int ispec
     
     
     #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
-        vecPatches(ipatch)->vecSpecies[ispec]->sort_part();
+    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+        if ( vecPatches(ipatch)->vecSpecies[ispec]->cell_sorting )
+            vecPatches(ipatch)->vecSpecies[ispec]->cell_sort_part();
+        else
+            vecPatches(ipatch)->vecSpecies[ispec]->sort_part();
+    }
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Same as finalize_and_sort_parts for all the species listed at once, with the messages aggregated per MPI process
+// (aggregate_particle_messages) : for each direction, the particles of all the species are exchanged together
+// by exchangeParticlesPerRank, between Patch::CommParticles and Patch::finalizeCommParticles.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::finalize_and_sort_parts_per_rank(VectorPatch& vecPatches, vector<unsigned int> &species, Params &params, SmileiMPI* smpi, Timers &timers, int itime)
+{
+    for (unsigned int iDim=0 ; iDim<params.nDim_particle ; iDim++) {
+        // Direction 0 initialized by exchangeParticles
+        if (iDim>0) {
+            #pragma omp for schedule(runtime)
+            for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+                for (unsigned int i=0 ; i<species.size() ; i++)
+                    vecPatches(ipatch)->initCommParticles(smpi, species[i], params, iDim, &vecPatches);
+        }
+        
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+            for (unsigned int i=0 ; i<species.size() ; i++)
+                vecPatches(ipatch)->CommParticles(smpi, species[i], params, iDim, &vecPatches);
+        
+        #pragma omp single
+        exchangeParticlesPerRank(vecPatches, species, iDim, smpi);
+        
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+            for (unsigned int i=0 ; i<species.size() ; i++)
+                vecPatches(ipatch)->finalizeCommParticles(smpi, species[i], params, iDim, &vecPatches);
+    }
+    
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+        for (unsigned int i=0 ; i<species.size() ; i++) {
+            if ( vecPatches(ipatch)->vecSpecies[species[i]]->cell_sorting )
+                vecPatches(ipatch)->vecSpecies[species[i]]->cell_sort_part();
+            else
+                vecPatches(ipatch)->vecSpecies[species[i]]->sort_part();
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// For direction iDim, exchange the particles packed by Patch::CommParticles with a single message per MPI process
+// and per direction for all the species listed, instead of one message per patch and per species
+// (aggregate_particle_messages).
+// A message starts with its number of entries, then for each entry the hindex of the destination patch, the species
+// and its number of particles, followed by the packed particles of all entries.
+// Called by a single thread. Received particles are left packed in the buffers of the destination patches,
+// unpacked by Patch::finalizeCommParticles.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::exchangeParticlesPerRank(VectorPatch& vecPatches, vector<unsigned int> &species, int iDim, SmileiMPI* smpi)
+{
+    int h0 = vecPatches(0)->hindex;
+    // Size of a packed particle, per species (it depends on the properties stored)
+    unsigned int nspec = vecPatches(0)->vecSpecies.size();
+    vector<unsigned int> packed_size( nspec, 0 );
+    for (unsigned int i=0 ; i<species.size() ; i++)
+        packed_size[species[i]] = vecPatches(0)->vecSpecies[species[i]]->particles->packedSize();
+    
+    vector<MPI_Request> requests;
+    
+    for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+        int tag = 2*iDim + iNeighbor;
+        
+        // Patches sending particles to each process, and processes sending particles to this one
+        map<int, vector<unsigned int> > send_patches;
+        set<int> recv_ranks;
+        for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++) {
+            if ( vecPatches(ipatch)->is_a_MPI_neighbor(iDim, iNeighbor) )
+                send_patches[ vecPatches(ipatch)->MPI_neighbor_[iDim][iNeighbor] ].push_back( ipatch );
+            if ( vecPatches(ipatch)->is_a_MPI_neighbor(iDim, (iNeighbor+1)%2) )
+                recv_ranks.insert( vecPatches(ipatch)->MPI_neighbor_[iDim][(iNeighbor+1)%2] );
+        }
+        
+        // Build and send one message per process, even empty, so that the receiver knows how many to expect
+        for (map<int, vector<unsigned int> >::iterator it=send_patches.begin() ; it!=send_patches.end() ; it++) {
+            vector<char> &buffer = vecPatches.rank_send_buffers[iNeighbor][it->first];
+            vector<int> header(1, 0);
+            size_t nbytes(0);
+            for (unsigned int i=0 ; i<it->second.size() ; i++) {
+                Patch* patch = vecPatches( it->second[i] );
+                for (unsigned int j=0 ; j<species.size() ; j++) {
+                    int npart = patch->vecSpecies[species[j]]->MPIbuff.part_index_send[iDim][iNeighbor].size();
+                    if (npart==0) continue;
+                    header[0]++;
+                    header.push_back( patch->neighbor_[iDim][iNeighbor] );
+                    header.push_back( species[j] );
+                    header.push_back( npart );
+                    nbytes += npart*packed_size[species[j]];
+                }
+            }
+            buffer.resize( header.size()*sizeof(int) + nbytes );
+            memcpy( &buffer[0], &header[0], header.size()*sizeof(int) );
+            size_t pos = header.size()*sizeof(int);
+            for (unsigned int i=0 ; i<it->second.size() ; i++) {
+                Patch* patch = vecPatches( it->second[i] );
+                for (unsigned int j=0 ; j<species.size() ; j++) {
+                    SpeciesMPIbuffers &MPIbuff = patch->vecSpecies[species[j]]->MPIbuff;
+                    size_t patch_bytes = MPIbuff.part_index_send[iDim][iNeighbor].size() * packed_size[species[j]];
+                    if (patch_bytes==0) continue;
+                    memcpy( &buffer[pos], &(MPIbuff.bufferSend[iDim][iNeighbor][0]), patch_bytes );
+                    pos += patch_bytes;
+                }
+            }
+            requests.push_back( MPI_REQUEST_NULL );
+            MPI_Isend( &buffer[0], buffer.size(), MPI_BYTE, it->first, tag, smpi->SMILEI_COMM_PARTICLES, &requests.back() );
+        }
+        
+        // Receive the message of each process, and dispatch the particles to the destination patches
+        // (messages are matched by source: a process may already have sent its message for the next time step)
+        for (set<int>::iterator it=recv_ranks.begin() ; it!=recv_ranks.end() ; it++) {
+            MPI_Status status;
+            int nbytes;
+            MPI_Probe( *it, tag, smpi->SMILEI_COMM_PARTICLES, &status );
+            MPI_Get_count( &status, MPI_BYTE, &nbytes );
+            vecPatches.rank_recv_buffer.resize( nbytes );
+            MPI_Recv( &(vecPatches.rank_recv_buffer[0]), nbytes, MPI_BYTE, *it, tag, smpi->SMILEI_COMM_PARTICLES, &status );
+            
+            const char* buffer = &(vecPatches.rank_recv_buffer[0]);
+            int nentries;
+            memcpy( &nentries, buffer, sizeof(int) );
+            vector<int> header( 3*nentries );
+            if (nentries>0)
+                memcpy( &header[0], buffer+sizeof(int), 3*nentries*sizeof(int) );
+            size_t pos = (1+3*nentries)*sizeof(int);
+            for (int ientry=0 ; ientry<nentries ; ientry++) {
+                int ispec = header[3*ientry+1];
+                SpeciesMPIbuffers &MPIbuff = vecPatches( header[3*ientry]-h0 )->vecSpecies[ispec]->MPIbuff;
+                size_t patch_bytes = header[3*ientry+2] * packed_size[ispec];
+                MPIbuff.part_index_recv_sz[iDim][(iNeighbor+1)%2] = header[3*ientry+2];
+                MPIbuff.bufferRecv[iDim][(iNeighbor+1)%2].assign( buffer+pos, buffer+pos+patch_bytes );
+                pos += patch_bytes;
+            }
+        }
+    }
+    
+    // Send buffers are kept for the next exchange
+    if (requests.size()>0)
+        MPI_Waitall( requests.size(), &requests[0], MPI_STATUSES_IGNORE );
+    
+} // END exchangeParticlesPerRank
+
+
 void SyncVectorPatch::sumRhoJ(VectorPatch& vecPatches, Timers &timers, int itime)
 {
     SyncVectorPatch::new_sum( vecPatches.densities , vecPatches, timers, itime );
@@ -101,12 +277,14 @@ void SyncVectorPatch::exchangeE( VectorPatch& vecPatches )
     SyncVectorPatch::exchange( vecPatches.listEz_, vecPatches );
 }
 
-void SyncVectorPatch::finalizeexchangeE( VectorPatch& vecPatches )
+void SyncVectorPatch::finalizeexchangeE( VectorPatch& vecPatches, SmileiMPI* smpi )
 {
 
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, false );
     SyncVectorPatch::finalizeexchange( vecPatches.listEx_, vecPatches );
     SyncVectorPatch::finalizeexchange( vecPatches.listEy_, vecPatches );
     SyncVectorPatch::finalizeexchange( vecPatches.listEz_, vecPatches );
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, true );
 }
 
 void SyncVectorPatch::exchangeB( VectorPatch& vecPatches )
@@ -135,17 +313,20 @@ void SyncVectorPatch::exchangeJ( VectorPatch& vecPatches )
     SyncVectorPatch::exchange( vecPatches.listJz_, vecPatches );
 }
 
-void SyncVectorPatch::finalizeexchangeJ( VectorPatch& vecPatches )
+void SyncVectorPatch::finalizeexchangeJ( VectorPatch& vecPatches, SmileiMPI* smpi )
 {
 
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, false );
     SyncVectorPatch::finalizeexchange( vecPatches.listJx_, vecPatches );
     SyncVectorPatch::finalizeexchange( vecPatches.listJy_, vecPatches );
     SyncVectorPatch::finalizeexchange( vecPatches.listJz_, vecPatches );
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, true );
 }
 
 
-void SyncVectorPatch::finalizeexchangeB( VectorPatch& vecPatches )
+void SyncVectorPatch::finalizeexchangeB( VectorPatch& vecPatches, SmileiMPI* smpi )
 {
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, false );
     if (vecPatches.listBx_[0]->dims_.size()==1) {
         SyncVectorPatch::new_finalizeexchange0( vecPatches.Bs0, vecPatches );
     }
@@ -158,6 +339,87 @@ void SyncVectorPatch::finalizeexchangeB( VectorPatch& vecPatches )
         SyncVectorPatch::new_finalizeexchange1( vecPatches.Bs1, vecPatches );
         SyncVectorPatch::new_finalizeexchange2( vecPatches.Bs2, vecPatches );
     }
+    SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, true );
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// The ghost cells of E are not exchanged by the Yee solver : E is computed on them from B and J, and stays valid as
+// long as B is exchanged at each timestep. After a vacuum block (temporal_blocking), E and B are both wrong near the
+// edges of the patches, and in the corners of the ghost cells : the directions are exchanged one after the other,
+// each one with the ghost cells of the previous ones up to date. E then B, their messages have the same tags.
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::exchangeEB( VectorPatch& vecPatches, SmileiMPI* smpi )
+{
+    std::vector<Field*>* lists[2][3] = { { &vecPatches.listEx_, &vecPatches.listEy_, &vecPatches.listEz_ },
+                                         { &vecPatches.listBx_, &vecPatches.listBy_, &vecPatches.listBz_ } };
+    unsigned int nDim = vecPatches.listBx_[0]->dims_.size();
+    
+    for ( unsigned int iDim=0 ; iDim<nDim ; iDim++ ) {
+        for ( int iEB=0 ; iEB<2 ; iEB++ ) {
+            for ( int icomp=0 ; icomp<3 ; icomp++ ) {
+                if      (iDim==0) SyncVectorPatch::exchange0( *lists[iEB][icomp], vecPatches );
+                else if (iDim==1) SyncVectorPatch::exchange1( *lists[iEB][icomp], vecPatches );
+                else              SyncVectorPatch::exchange2( *lists[iEB][icomp], vecPatches );
+            }
+            SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, false );
+            for ( int icomp=0 ; icomp<3 ; icomp++ ) {
+                if      (iDim==0) SyncVectorPatch::finalizeexchange0( *lists[iEB][icomp], vecPatches );
+                else if (iDim==1) SyncVectorPatch::finalizeexchange1( *lists[iEB][icomp], vecPatches );
+                else              SyncVectorPatch::finalizeexchange2( *lists[iEB][icomp], vecPatches );
+            }
+            SyncVectorPatch::syncSharedGhosts( vecPatches, smpi, true );
+        }
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Ghost layers exchanged with the processes of the node through the shared memory window :
+//   - packed in PatchXD::initExchange, the window is synchronized before they are read in PatchXD::finalizeExchange
+//   - at the end of the exchange, synchronized again so that no process overwrites them while they are read
+// All processes of the node run the same sequence of exchanges, as for the MPI messages
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::syncSharedGhosts( VectorPatch& vecPatches, SmileiMPI* smpi, bool end_of_exchange )
+{
+    if ( !smpi->sharedGhosts() ) return;
+    
+    #pragma omp single
+    {
+        smpi->syncGhostWindow();
+        if ( end_of_exchange )
+            for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+                vecPatches(ipatch)->resetSharedGhosts();
+    }
+
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Ghost layers exchanged through the neighborhood collective of the process :
+//   - posted in PatchXD::initExchange / initSumField, instead of MPI_Isend/Irecv
+//   - one MPI_Ineighbor_alltoallv per exchange, unpacked before PatchXD::finalizeExchange / finalizeSumField
+// All processes run the same sequence of exchanges, as required by the collectives
+// ---------------------------------------------------------------------------------------------------------------------
+void SyncVectorPatch::startNeighborhood( VectorPatch& vecPatches, const void* key, int iDim )
+{
+    NeighborhoodExchange* neighborhood = vecPatches(0)->neighborhood();
+    if ( !neighborhood ) return;
+    
+    #pragma omp single
+    neighborhood->start( key, iDim );
+
+}
+
+
+void SyncVectorPatch::completeNeighborhood( VectorPatch& vecPatches, const void* key, int iDim )
+{
+    NeighborhoodExchange* neighborhood = vecPatches(0)->neighborhood();
+    if ( !neighborhood ) return;
+    
+    #pragma omp single
+    neighborhood->complete( key, iDim );
 
 }
 
@@ -192,6 +454,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
         vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+  nPatchMPIx], 0 ); // Jy
         vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIx[ifield+2*nPatchMPIx], 0 ); // Jz
     }
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 0 );
+
     // iDim = 0, local
     int nFieldLocalx = vecPatches.densitiesLocalx.size()/3;
     for ( int icomp=0 ; icomp<3 ; icomp++ ) {
@@ -224,6 +488,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
         }
     }
     
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 0 );
+
     // iDim = 0, finalize (waitall)
     #pragma omp for schedule(static) 
     for (unsigned int ifield=0 ; ifield<nPatchMPIx ; ifield++) {
@@ -249,6 +515,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
             vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIy[ifield+2*nPatchMPIy], 1 ); // Jz
         }
         
+        SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 1 );
+
         // iDim = 1, 
         int nFieldLocaly = vecPatches.densitiesLocaly.size()/3;
         for ( int icomp=0 ; icomp<3 ; icomp++ ) {
@@ -285,6 +553,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
             }
         }
         
+        SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 1 );
+
         // iDim = 1, finalize (waitall)
         #pragma omp for schedule(static) 
         for (unsigned int ifield=0 ; ifield<nPatchMPIy ; ifield=ifield+1) {
@@ -310,6 +580,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
                 vecPatches(ipatch)->initSumField( vecPatches.densitiesMPIz[ifield+2*nPatchMPIz], 2 ); // Jz
             }
             
+            SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 2 );
+
             // iDim = 2 local
             int nFieldLocalz = vecPatches.densitiesLocalz.size()/3;
             for ( int icomp=0 ; icomp<3 ; icomp++ ) {
@@ -349,6 +621,8 @@ void SyncVectorPatch::new_sum( std::vector<Field*>& fields, VectorPatch& vecPatc
                 }
             }
             
+            SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 2 );
+
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
             #pragma omp for schedule(static)
             for (unsigned int ifield=0 ; ifield<nPatchMPIz ; ifield=ifield+1) {
@@ -401,6 +675,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
 //        vecPatches(ipatch)->testSumField( fields[ifield], 0 );
 //    }
     
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 0 );
+
     // iDim = 0, local
     for (unsigned int icomp=0 ; icomp<nComp ; icomp++) {
         nx_ = fields[icomp*nPatches]->dims_[0];
@@ -427,6 +703,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
         }
     }
     
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 0 );
+
     // iDim = 0, finalize (waitall)
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
@@ -453,6 +731,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
 //            vecPatches(ipatch)->testSumField( fields[ifield], 1 );
 //        }
         
+        SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 1 );
+
         // iDim = 1, local
         for (unsigned int icomp=0 ; icomp<nComp ; icomp++) {
             nx_ = fields[icomp*nPatches]->dims_[0];
@@ -483,6 +763,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
             }
         }
         
+        SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 1 );
+
         // iDim = 1, finalize (waitall)
         #pragma omp for schedule(static)
         for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
@@ -503,6 +785,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
                 vecPatches(ipatch)->initSumField( fields[ifield], 2 );
             }
             
+            SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 2 );
+
             // iDim = 2 local
             for (unsigned int icomp=0 ; icomp<nComp ; icomp++) {
                 nx_ = fields[icomp*nPatches]->dims_[0];
@@ -535,6 +819,8 @@ void SyncVectorPatch::sum( std::vector<Field*> fields, VectorPatch& vecPatches,
                 }
             }
             
+            SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 2 );
+
             // iDim = 2, complete non local sync through MPIfinalize (waitall)
             #pragma omp for schedule(static)
             for (unsigned int ifield=0 ; ifield<fields.size() ; ifield++){
@@ -558,6 +844,7 @@ void SyncVectorPatch::exchange( std::vector<Field*> fields, VectorPatch& vecPatc
         for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
             vecPatches(ipatch)->initExchange( fields[ipatch], iDim );
     } // End for iDim
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], -1 );
     
     
     unsigned int nx_, ny_(1), nz_(1), h0, oversize[3], n_space[3], gsp[3];
@@ -629,6 +916,7 @@ void SyncVectorPatch::exchange( std::vector<Field*> fields, VectorPatch& vecPatc
 
 void SyncVectorPatch::finalizeexchange( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], -1 );
     for ( unsigned int iDim=0 ; iDim<fields[0]->dims_.size() ; iDim++ ) {
         #pragma omp for schedule(static)
         for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
@@ -643,6 +931,7 @@ void SyncVectorPatch::exchange0( std::vector<Field*> fields, VectorPatch& vecPat
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->initExchange( fields[ipatch], 0 );
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 0 );
     
     unsigned int ny_(1), nz_(1), h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -689,6 +978,7 @@ void SyncVectorPatch::new_exchange0( std::vector<Field*>& fields, VectorPatch& v
         vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield      ], 0 ); // By
         vecPatches(ipatch)->initExchange( vecPatches.B_MPIx[ifield+nMPIx], 0 ); // Bz
     }
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 0 );
     
     
     unsigned int h0, oversize, n_space;
@@ -736,6 +1026,7 @@ void SyncVectorPatch::new_exchange0( std::vector<Field*>& fields, VectorPatch& v
 
 void SyncVectorPatch::new_finalizeexchange0( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 0 );
     unsigned int nMPIx = vecPatches.MPIxIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIx ; ifield++) {
@@ -747,6 +1038,7 @@ void SyncVectorPatch::new_finalizeexchange0( std::vector<Field*>& fields, Vector
 
 void SyncVectorPatch::finalizeexchange0( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 0 );
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->finalizeExchange( fields[ipatch], 0 );
@@ -762,6 +1054,7 @@ void SyncVectorPatch::new_exchange1( std::vector<Field*>& fields, VectorPatch& v
         vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield], 1 );   // Bx
         vecPatches(ipatch)->initExchange( vecPatches.B1_MPIy[ifield+nMPIy], 1 ); // Bz
     }
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 1 );
     
     unsigned int h0, oversize, n_space;
     double *pt1,*pt2;
@@ -812,6 +1105,7 @@ void SyncVectorPatch::exchange1( std::vector<Field*> fields, VectorPatch& vecPat
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->initExchange( fields[ipatch], 1 );
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 1 );
     
     unsigned int nx_, ny_, nz_(1), h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -851,6 +1145,7 @@ void SyncVectorPatch::exchange1( std::vector<Field*> fields, VectorPatch& vecPat
 
 void SyncVectorPatch::new_finalizeexchange1( std::vector<Field*>& fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 1 );
     unsigned int nMPIy = vecPatches.MPIyIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIy ; ifield++) {
@@ -863,6 +1158,7 @@ void SyncVectorPatch::new_finalizeexchange1( std::vector<Field*>& fields, Vector
 }
 void SyncVectorPatch::finalizeexchange1( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 1 );
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->finalizeExchange( fields[ipatch], 1 );
@@ -879,6 +1175,7 @@ void SyncVectorPatch::new_exchange2( std::vector<Field*> fields, VectorPatch& ve
         vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield],       2 ); // Bx
         vecPatches(ipatch)->initExchange( vecPatches.B2_MPIz[ifield+nMPIz], 2 ); // By
     }
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 2 );
     
     unsigned int h0, oversize, n_space;
     double *pt1,*pt2;
@@ -929,6 +1226,7 @@ void SyncVectorPatch::exchange2( std::vector<Field*> fields, VectorPatch& vecPat
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->initExchange( fields[ipatch], 2 );
+    SyncVectorPatch::startNeighborhood( vecPatches, fields[0], 2 );
 
     unsigned int nx_, ny_, nz_, h0, oversize, n_space, gsp;
     double *pt1,*pt2;
@@ -966,6 +1264,7 @@ void SyncVectorPatch::exchange2( std::vector<Field*> fields, VectorPatch& vecPat
 
 void SyncVectorPatch::new_finalizeexchange2( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 2 );
     unsigned int nMPIz = vecPatches.MPIzIdx.size();
     #pragma omp for schedule(static)
     for (unsigned int ifield=0 ; ifield<nMPIz ; ifield++) {
@@ -978,6 +1277,7 @@ void SyncVectorPatch::new_finalizeexchange2( std::vector<Field*> fields, VectorP
 
 void SyncVectorPatch::finalizeexchange2( std::vector<Field*> fields, VectorPatch& vecPatches )
 {
+    SyncVectorPatch::completeNeighborhood( vecPatches, fields[0], 2 );
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<fields.size() ; ipatch++)
         vecPatches(ipatch)->finalizeExchange( fields[ipatch], 2 );
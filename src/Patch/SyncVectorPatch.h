@@ -15,18 +15,30 @@ public :
 
     static void exchangeParticles(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
     static void finalize_and_sort_parts(VectorPatch& vecPatches, int ispec, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
+    static void finalize_and_sort_parts_per_rank(VectorPatch& vecPatches, std::vector<unsigned int> &species, Params &params, SmileiMPI* smpi, Timers &timers, int itime);
+    static void exchangeParticlesPerRank(VectorPatch& vecPatches, std::vector<unsigned int> &species, int iDim, SmileiMPI* smpi);
     static void sumRhoJ  ( VectorPatch& vecPatches, Timers &timers, int itime );
     static void sumRhoJs ( VectorPatch& vecPatches, int ispec, Timers &timers, int itime );
     static void exchangeE( VectorPatch& vecPatches );
-    static void finalizeexchangeE( VectorPatch& vecPatches );
+    static void finalizeexchangeE( VectorPatch& vecPatches, SmileiMPI* smpi );
     static void exchangeB( VectorPatch& vecPatches );
     static void exchangeJ( VectorPatch& vecPatches );
-    static void finalizeexchangeJ( VectorPatch& vecPatches );
-    static void finalizeexchangeB( VectorPatch& vecPatches );
+    static void finalizeexchangeJ( VectorPatch& vecPatches, SmileiMPI* smpi );
+    static void finalizeexchangeB( VectorPatch& vecPatches, SmileiMPI* smpi );
+    //! Exchange the ghost cells of all the components of E and B, one direction after the other so that the corners
+    //! are exchanged too, completed on return (end of a vacuum block, see temporal_blocking)
+    static void exchangeEB( VectorPatch& vecPatches, SmileiMPI* smpi );
     static void sum      ( std::vector<Field*> fields, VectorPatch& vecPatches, Timers &timers, int itime );
     static void new_sum      ( std::vector<Field*>& fields, VectorPatch& vecPatches, Timers &timers, int itime );
     static void exchange ( std::vector<Field*> fields, VectorPatch& vecPatches );
     static void finalizeexchange( std::vector<Field*> fields, VectorPatch& vecPatches );
+    //! Synchronize the ghost layers exchanged through the shared memory window of the node (shared_memory_ghosts) :
+    //! before the finalization of an exchange, and at its end (end_of_exchange) before the slots can be reused
+    static void syncSharedGhosts( VectorPatch& vecPatches, SmileiMPI* smpi, bool end_of_exchange );
+    //! Neighborhood collective of the ghost layers posted by the patches since the last one (neighborhood_collectives) :
+    //! started once the patches posted their messages, completed before their finalization (same key and iDim)
+    static void startNeighborhood( VectorPatch& vecPatches, const void* key, int iDim );
+    static void completeNeighborhood( VectorPatch& vecPatches, const void* key, int iDim );
     static void exchange0( std::vector<Field*> fields, VectorPatch& vecPatches );
     static void new_exchange0( std::vector<Field*>& fields, VectorPatch& vecPatches );
     static void finalizeexchange0( std::vector<Field*> fields, VectorPatch& vecPatches );
@@ -5,6 +5,7 @@
 #include <iomanip>
 #include <fstream>
 #include <cstring>
+#include <algorithm>
 //#include <string>
 
 #include "Collisions.h"
@@ -25,6 +26,8 @@ using namespace std;
 
 VectorPatch::VectorPatch()
 {
+    vacuum_block_ = false;
+    vacuum_steps_ = 0;
 }
 
 
@@ -103,18 +106,26 @@ void VectorPatch::dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow
     
     timers.particles.restart();
     ostringstream t;
-    #pragma omp for schedule(runtime)
-    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
-        (*this)(ipatch)->EMfields->restartRhoJ();
-        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
-            if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
-                species(ipatch, ispec)->dynamics(time_dual, ispec,
-                                                 emfields(ipatch), interp(ipatch), proj(ipatch),
-                                                 params, diag_flag, partwalls(ipatch),
-                                                 (*this)(ipatch), smpi, localDiags);
+    if ( params.tiled_currents )
+        dynamicsTiled(params, smpi, simWindow, time_dual);
+    else if ( params.heavy_patch_factor > 0. )
+        dynamicsHeavyPatches(params, smpi, simWindow, time_dual);
+    else {
+        #pragma omp for schedule(runtime)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+            double start = MPI_Wtime();
+            (*this)(ipatch)->EMfields->restartRhoJ();
+            for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+                if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
+                    species(ipatch, ispec)->dynamics(time_dual, ispec,
+                                                     emfields(ipatch), interp(ipatch), proj(ipatch),
+                                                     params, diag_flag, partwalls(ipatch),
+                                                     (*this)(ipatch), smpi, localDiags);
+                }
             }
+            (*this)(ipatch)->addMeasuredLoad( MPI_Wtime()-start );
+        
         }
-    
     }
     timers.particles.update( params.printNow( itime ) );
 
@@ -123,7 +134,8 @@ void VectorPatch::dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow
 //    timers.syncField.update(  params.printNow( itime ) );
     
     timers.syncPart.restart();
-    for (unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size(); ispec++) {
+    // No particle to exchange in a vacuum block
+    for (unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size() && !vacuum_block_ ; ispec++) {
         if ( (*this)(0)->vecSpecies[ispec]->isProj(time_dual, simWindow) ){
             SyncVectorPatch::exchangeParticles((*this), ispec, params, smpi, timers, itime ); // Included sort_part
         }
@@ -133,13 +145,176 @@ void VectorPatch::dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow
 } // END dynamics
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Particle dynamics with tiled_currents: the bins of moving species are distributed among the threads, instead of
+// the patches, and each bin projects its currents in a thread-private tile (see Species::dynamicsTiled).
+// Ionizing and frozen species are processed patch by patch, before the bins : the electrons created by ionization
+// are imported in their species before its list of particles to exchange is built.
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::dynamicsTiled(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual)
+{
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        (*this)(ipatch)->EMfields->restartRhoJ();
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++)
+            species(ipatch, ispec)->clearExchList();
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            Species* spec = species(ipatch, ispec);
+            if ( !spec->isProj(time_dual, simWindow) && !diag_flag ) continue;
+            if ( time_dual<=spec->time_frozen || spec->Ionize ) {
+                double start = MPI_Wtime();
+                spec->dynamics(time_dual, ispec,
+                               emfields(ipatch), interp(ipatch), proj(ipatch),
+                               params, diag_flag, partwalls(ipatch),
+                               (*this)(ipatch), smpi, localDiags);
+                (*this)(ipatch)->addMeasuredLoad( MPI_Wtime()-start );
+            }
+        }
+    }
+    
+    // One task per bin of the species which are moving and not ionizing
+    #pragma omp single
+    {
+        tiled_tasks.clear();
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+            for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+                Species* spec = species(ipatch, ispec);
+                if ( !spec->isProj(time_dual, simWindow) && !diag_flag ) continue;
+                if ( time_dual<=spec->time_frozen || spec->Ionize ) continue;
+                for (unsigned int ibin=0 ; ibin<spec->bmin.size() ; ibin++) {
+                    TiledTask task = { ipatch, ispec, ibin, ibin+1 };
+                    tiled_tasks.push_back( task );
+                }
+            }
+        }
+    }
+    
+    #pragma omp for schedule(dynamic)
+    for (unsigned int itask=0 ; itask<tiled_tasks.size() ; itask++) {
+        TiledTask &task = tiled_tasks[itask];
+        double start = MPI_Wtime();
+        species(task.ipatch, task.ispec)->dynamicsTiled(task.ibin_min, task.ibin_max, task.ispec,
+                                                        emfields(task.ipatch), interp(task.ipatch), proj(task.ipatch),
+                                                        params, diag_flag, partwalls(task.ipatch), smpi);
+        (*this)(task.ipatch)->addMeasuredLoad( MPI_Wtime()-start );
+    }
+    
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            Species* spec = species(ipatch, ispec);
+            if ( !spec->isProj(time_dual, simWindow) && !diag_flag ) continue;
+            if ( time_dual<=spec->time_frozen || spec->Ionize ) continue;
+            // Bins may have been processed in any order
+            std::sort( spec->indexes_of_particles_to_exchange.begin(), spec->indexes_of_particles_to_exchange.end() );
+        }
+    }
+    
+} // END dynamicsTiled
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Particle dynamics with heavy_patch_factor: patches are processed one per thread as usual, except the heavy ones
+// whose bins are processed as OpenMP tasks. Bins of a heavy patch are coloured: bins of the same colour are at least
+// b_dim[0] cells apart, so that they never project on the same rows and run concurrently without any buffer.
+// Ionizing species are always processed patch by patch.
+// ---------------------------------------------------------------------------------------------------------------------
+void VectorPatch::dynamicsHeavyPatches(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual)
+{
+    // Cost of a patch: number of particles which may be split in tasks
+    #pragma omp single
+    {
+        is_heavy.resize( (*this).size() );
+        vector<unsigned int> cost( (*this).size(), 0 );
+        double mean_cost(0.);
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+            for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++)
+                if ( isSplittable(ipatch, ispec, time_dual, simWindow) )
+                    cost[ipatch] += species(ipatch, ispec)->getNbrOfParticles();
+            mean_cost += cost[ipatch];
+        }
+        mean_cost /= (*this).size();
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++)
+            is_heavy[ipatch] = cost[ipatch] > params.heavy_patch_factor * mean_cost
+                            && species(ipatch, 0)->bmin.size() > 1;
+    }
+    
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        double start = MPI_Wtime();
+        (*this)(ipatch)->EMfields->restartRhoJ();
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            if ( is_heavy[ipatch] && isSplittable(ipatch, ispec, time_dual, simWindow) )
+                species(ipatch, ispec)->clearExchList();
+            else if ( (*this)(ipatch)->vecSpecies[ispec]->isProj(time_dual, simWindow) || diag_flag  ) {
+                species(ipatch, ispec)->dynamics(time_dual, ispec,
+                                                 emfields(ipatch), interp(ipatch), proj(ipatch),
+                                                 params, diag_flag, partwalls(ipatch),
+                                                 (*this)(ipatch), smpi, localDiags);
+            }
+        }
+        (*this)(ipatch)->addMeasuredLoad( MPI_Wtime()-start );
+    }
+    
+    // Tasks: one per bin of a heavy patch, for all its splittable species (they project on the same arrays)
+    #pragma omp single
+    {
+        // Number of colours such that bins of the same colour do not overlap (see Species::b_dim)
+        unsigned int b_dim0 = ( 1 + params.clrw ) + 2 * params.oversize[0];
+        unsigned int ncolours = ( b_dim0 + params.clrw - 1 ) / params.clrw;
+        for (unsigned int icolour=0 ; icolour<ncolours ; icolour++) {
+            for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+                if ( !is_heavy[ipatch] ) continue;
+                for (unsigned int ibin=icolour ; ibin<species(ipatch, 0)->bmin.size() ; ibin+=ncolours) {
+                    #pragma omp task firstprivate(ipatch, ibin)
+                    {
+                        double start = MPI_Wtime();
+                        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++)
+                            if ( isSplittable(ipatch, ispec, time_dual, simWindow) )
+                                species(ipatch, ispec)->dynamicsBinTask(ibin, ispec,
+                                                                        emfields(ipatch), interp(ipatch), proj(ipatch),
+                                                                        params, diag_flag, partwalls(ipatch), smpi);
+                        (*this)(ipatch)->addMeasuredLoad( MPI_Wtime()-start );
+                    }
+                }
+            }
+            #pragma omp taskwait
+        }
+    }
+    
+    #pragma omp for schedule(runtime)
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
+        if ( !is_heavy[ipatch] ) continue;
+        for (unsigned int ispec=0 ; ispec<(*this)(ipatch)->vecSpecies.size() ; ispec++) {
+            if ( isSplittable(ipatch, ispec, time_dual, simWindow) ) {
+                // Bins may have been processed in any order
+                Species* spec = species(ipatch, ispec);
+                std::sort( spec->indexes_of_particles_to_exchange.begin(), spec->indexes_of_particles_to_exchange.end() );
+            }
+        }
+    }
+    
+} // END dynamicsHeavyPatches
+
+
 void VectorPatch::finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWindow* simWindow,
                            double time_dual, Timers &timers, int itime)
 {
     timers.syncPart.restart();
-    for (unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size(); ispec++) {
-        if ( (*this)(0)->vecSpecies[ispec]->isProj(time_dual, simWindow) ){
-            SyncVectorPatch::finalize_and_sort_parts((*this), ispec, params, smpi, timers, itime ); // Included sort_part
+    // No particle to exchange in a vacuum block
+    if ( !vacuum_block_ && params.aggregate_particle_messages ) {
+        // All the species in the same messages
+        vector<unsigned int> species;
+        for (unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size(); ispec++)
+            if ( (*this)(0)->vecSpecies[ispec]->isProj(time_dual, simWindow) )
+                species.push_back( ispec );
+        SyncVectorPatch::finalize_and_sort_parts_per_rank((*this), species, params, smpi, timers, itime ); // Included sort_part
+    }
+    else if ( !vacuum_block_ ) {
+        for (unsigned int ispec=0 ; ispec<(*this)(0)->vecSpecies.size(); ispec++) {
+            if ( (*this)(0)->vecSpecies[ispec]->isProj(time_dual, simWindow) ){
+                SyncVectorPatch::finalize_and_sort_parts((*this), ispec, params, smpi, timers, itime ); // Included sort_part
+            }
         }
     }
     if (itime%params.every_clean_particles_overhead==0) {
@@ -152,7 +327,9 @@ void VectorPatch::finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWi
 
     if ( (itime!=0) && ( time_dual > params.time_fields_frozen ) ) {
         timers.syncField.restart();
-        SyncVectorPatch::finalizeexchangeB( (*this) );
+        // In a vacuum block, exchanges completed in solveMaxwell
+        if ( !vacuum_block_ )
+            SyncVectorPatch::finalizeexchangeB( (*this), smpi );
         timers.syncField.update(  params.printNow( itime ) );
 
         #pragma omp for schedule(static)
@@ -162,6 +339,11 @@ void VectorPatch::finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWi
             // Computes B at time n using B and B_m.
             (*this)(ipatch)->EMfields->centerMagneticFields();
         }
+        
+        if ( params.temporal_blocking > 1 ) {
+            #pragma omp single
+            updateVacuumBlock( params, smpi, simWindow, itime, time_dual );
+        }
     }
 
 } // END dynamics
@@ -193,6 +375,9 @@ void VectorPatch::sumDensities(Params &params, double time_dual, Timers &timers,
     }
     if ( !some_particles_are_moving  && !diag_flag )
         return;
+    // No particle, densities all zero in a vacuum block
+    if ( vacuum_block_ )
+        return;
 
 
     timers.densities.restart();
@@ -224,7 +409,7 @@ void VectorPatch::sumDensities(Params &params, double time_dual, Timers &timers,
 // ---------------------------------------------------------------------------------------------------------------------
 // For all patch, update E and B (Ampere, Faraday, boundary conditions, exchange B and center B)
 // ---------------------------------------------------------------------------------------------------------------------
-void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime, double time_dual, Timers & timers)
+void VectorPatch::solveMaxwell(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual, Timers & timers)
 {
     timers.maxwell.restart();
     
@@ -235,32 +420,139 @@ void VectorPatch::solveMaxwell(Params& params, SimWindow* simWindow, int itime,
             (*this)(ipatch)->EMfields->binomialCurrentFilter();
         }
         SyncVectorPatch::exchangeJ( (*this) );
-        SyncVectorPatch::finalizeexchangeJ( (*this) );
+        // The exchange of the last pass is finalized after the interior cells of E are computed
+        if ( ipassfilter+1 < params.currentFilter_int )
+            SyncVectorPatch::finalizeexchangeJ( (*this), smpi );
     }
+    bool J_exchange_pending = ( params.currentFilter_int > 0 );
+    // The spectral solver computes B from E on all the cells : the ghost cells of E exchanged before Maxwell-Faraday
+    bool E_exchange = ( params.maxwell_sol == "PSATD" );
     
     #pragma omp for schedule(static)
     for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+        if ( (*this)(ipatch)->EMfields->vacuum_ && !J_exchange_pending ) {
+            // Patch without particles nor fields : nothing to solve. Once it has some, never checked again
+            if ( (*this)(ipatch)->noParticles() && (*this)(ipatch)->EMfields->isVacuum() )
+                continue;
+            (*this)(ipatch)->EMfields->vacuum_ = false;
+        }
+        if ( !J_exchange_pending && (*this)(ipatch)->EMfields->MaxwellSolver_ ) {
+            // Saves B in B_m, computes E then B on all points, in a single pass over the fields
+            (*(*this)(ipatch)->EMfields->MaxwellSolver_)((*this)(ipatch)->EMfields);
+            continue;
+        }
         // Saving magnetic fields (to compute centered fields used in the particle pusher)
         // Stores B at time n in B_m.
         (*this)(ipatch)->EMfields->saveMagneticFields();
-        // Computes Ex_, Ey_, Ez_ on all points.
-        // E is already synchronized because J has been synchronized before.
-        (*(*this)(ipatch)->EMfields->MaxwellAmpereSolver_)((*this)(ipatch)->EMfields);
-        // Computes Bx_, By_, Bz_ at time n+1 on interior points.
-        //for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++) {
-        (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        if ( J_exchange_pending ) {
+            // Computes Ex_, Ey_, Ez_ out of the ghost cells of J, still being received
+            (*this)(ipatch)->EMfields->MaxwellAmpereSolver_->interior( (*this)(ipatch)->EMfields );
+        }
+        else {
+            // Computes Ex_, Ey_, Ez_ on all points.
+            // E is already synchronized because J has been synchronized before.
+            (*(*this)(ipatch)->EMfields->MaxwellAmpereSolver_)((*this)(ipatch)->EMfields);
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            if ( !E_exchange )
+                (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        }
+    }
+    
+    if ( J_exchange_pending ) {
+        SyncVectorPatch::finalizeexchangeJ( (*this), smpi );
+        #pragma omp for schedule(static)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+            // Computes Ex_, Ey_, Ez_ on the ghost cells of J
+            (*this)(ipatch)->EMfields->MaxwellAmpereSolver_->boundary( (*this)(ipatch)->EMfields );
+            // Computes Bx_, By_, Bz_ at time n+1 on interior points.
+            if ( !E_exchange )
+                (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        }
+    }
+    
+    if ( E_exchange ) {
+        SyncVectorPatch::exchangeE( (*this) );
+        SyncVectorPatch::finalizeexchangeE( (*this), smpi );
+        // Also in the vacuum patches skipped above : the ghost cells of E received may not be zero
+        #pragma omp for schedule(static)
+        for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++){
+            // Computes Bx_, By_, Bz_ at time n+1 on all points.
+            (*(*this)(ipatch)->EMfields->MaxwellFaradaySolver_)((*this)(ipatch)->EMfields);
+        }
     }
     
     //Synchronize B fields between patches.
     timers.maxwell.update( params.printNow( itime ) );
     
     timers.syncField.restart();
-    SyncVectorPatch::exchangeB( (*this) );
+    if ( !vacuum_block_ )
+        SyncVectorPatch::exchangeB( (*this) );
+    // In a vacuum block, E and B at its end only, completed here
+    else if ( vacuumBlockEnds(params, smpi, simWindow, itime, time_dual) )
+        SyncVectorPatch::exchangeEB( (*this), smpi );
     timers.syncField.update(  params.printNow( itime ) );
 
 } // END solveMaxwell
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Temporal blocking (temporal_blocking = K > 1) : while the simulation contains no particle, the fields are
+// advanced K timesteps between two exchanges of their ghost cells, instead of one.
+//   - the Yee solver invalidates one more ghost cell of E and B per timestep without exchange : the patches have
+//     K-1 more ghost cells (Params::compute), so that the cells read by the solver and the diagnostics stay valid
+//   - the blocks are decided for the whole simulation (MPI_Allreduce), at the end of each block, so that all the
+//     processes skip the same exchanges. In a block, the exchanges of particles and the sums of the densities are
+//     skipped too
+//   - a block ends after K timesteps, or before the patches move (moving window, load balancing)
+// The boundary conditions (Silver-Muller, lasers) are applied at each timestep, on the patches of the borders, K-1
+// cells inside the arrays (ElectroMagnBC::ghost_shift) : the added ghost cells do not move the boundaries.
+// ---------------------------------------------------------------------------------------------------------------------
+bool VectorPatch::patchesMove(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual)
+{
+    if ( simWindow && simWindow->isMoving(time_dual) )
+        return true;
+    if ( (params.balancing_every > 0) && (smpi->getSize()!=1) ) {
+        if ( itime%params.balancing_every == 0 )
+            return true;
+        if ( ( params.node_balancing_every > 0 ) && ( itime%params.node_balancing_every == 0 ) )
+            return true;
+    }
+    return false;
+}
+
+
+bool VectorPatch::vacuumBlockEnds(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual)
+{
+    return ( vacuum_steps_+1 >= params.temporal_blocking ) || patchesMove(params, smpi, simWindow, itime, time_dual);
+}
+
+
+// Called by a single thread, after the ghost cells of B are exchanged (if any), before the patches move
+void VectorPatch::updateVacuumBlock(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual)
+{
+    // Next timestep of the same block
+    if ( vacuum_block_ && !vacuumBlockEnds(params, smpi, simWindow, itime, time_dual) ) {
+        vacuum_steps_++;
+        return;
+    }
+    
+    // Ghost cells up to date : a new block may start, unless the patches move. Out of the blocks, checked every
+    // temporal_blocking timesteps
+    vacuum_steps_ = 0;
+    if ( !vacuum_block_ && ( itime%params.temporal_blocking != 0 ) ) 
+        return;
+    vacuum_block_ = false;
+    if ( patchesMove(params, smpi, simWindow, itime, time_dual) )
+        return;
+    int vacuum( 1 ), all_vacuum( 0 );
+    for (unsigned int ipatch=0 ; ipatch<(*this).size() ; ipatch++)
+        if ( !(*this)(ipatch)->noParticles() )
+            vacuum = 0;
+    MPI_Allreduce( &vacuum, &all_vacuum, 1, MPI_INT, MPI_LAND, smpi->SMILEI_COMM_WORLD );
+    vacuum_block_ = ( all_vacuum != 0 );
+}
+
+
 void VectorPatch::initExternals(Params& params)
 {
     // Init all lasers
@@ -452,7 +744,9 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
         
         // Exchange Ap_ (intra & extra MPI)
         SyncVectorPatch::exchange( Ap_, *this );
+        SyncVectorPatch::syncSharedGhosts( *this, smpi, false );
         SyncVectorPatch::finalizeexchange( Ap_, *this );
+        SyncVectorPatch::syncSharedGhosts( *this, smpi, true );
         
        // scalar product p.Ap
         double p_dot_Ap       = 0.0;
@@ -510,7 +804,7 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
         (*this)(ipatch)->EMfields->initE( (*this)(ipatch) );
 
     SyncVectorPatch::exchangeE( *this );    
-    SyncVectorPatch::finalizeexchangeE( *this );    
+    SyncVectorPatch::finalizeexchangeE( *this, smpi );    
 
     // Centering of the electrostatic fields
     // -------------------------------------
@@ -653,11 +947,15 @@ void VectorPatch::solvePoisson( Params &params, SmileiMPI* smpi )
 // ---------------------------------------------------------------------------------------------------------------------
 
 
-void VectorPatch::load_balance(Params& params, double time_dual, SmileiMPI* smpi, SimWindow* simWindow, unsigned int itime)
+void VectorPatch::load_balance(Params& params, double time_dual, SmileiMPI* smpi, SimWindow* simWindow, unsigned int itime, bool node_only)
 {
 
-    // Compute new patch distribution
-    smpi->recompute_patch_count( params, *this, time_dual );
+    // Ghost layers still exchanged received before the patches move
+    if ( smpi->neighborhood() )
+        smpi->neighborhood()->completeAll();
+    
+    // Compute new patch distribution (node_only : patches only move inside the nodes)
+    smpi->recompute_patch_count( params, *this, time_dual, node_only );
             
     // Create empty patches according to this new distribution
     this->createPatches(params, smpi, simWindow);
@@ -665,6 +963,10 @@ void VectorPatch::load_balance(Params& params, double time_dual, SmileiMPI* smpi
     // Proceed to patch exchange, and delete patch which moved
     this->exchangePatches(smpi, params);
     
+    // Measure the load again over the next interval
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+        patches_[ipatch]->measured_load = 0.;
+    
     // Tell that the patches moved this iteration (needed for probes)
     lastIterationPatchesMoved = itime;
 
@@ -777,39 +1079,46 @@ void VectorPatch::exchangePatches(SmileiMPI* smpi, Params& params)
         smpi->isend( (*this)(send_patch_id_[ipatch]), newMPIrank, (refHindex_+send_patch_id_[ipatch])*nmessage, params );
     }
     
+    // Post the receptions of all the incoming patches at once, so that they are transferred simultaneously
+    vector<int> recv_from( recv_patch_id_.size() );
     for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++) {
         //if  hindex of patch to be received > first hindex actually owned, that means it comes from the next MPI process and not from the previous anymore. 
         if(recv_patch_id_[ipatch] > refHindex_ ) oldMPIrank = smpi->getRank() + 1;
+        recv_from[ipatch] = oldMPIrank;
 
-        smpi->recv( recv_patches_[ipatch], oldMPIrank, recv_patch_id_[ipatch]*nmessage, params );
+        smpi->irecv( recv_patches_[ipatch], oldMPIrank, recv_patch_id_[ipatch]*nmessage, params );
     }
 
+    // Complete the receptions (particles, once their number is known)
+    for (unsigned int ipatch=0 ; ipatch < recv_patch_id_.size() ; ipatch++)
+        smpi->waitRecv( recv_patches_[ipatch], recv_from[ipatch], recv_patch_id_[ipatch]*nmessage, params );
 
-    for (unsigned int ipatch=0 ; ipatch < send_patch_id_.size() ; ipatch++)
-        smpi->waitall( (*this)(send_patch_id_[ipatch]) );
-    
-    smpi->barrier();
-    //Delete sent patches
+    // Delete the sent patches as soon as their sends are completed
+    // No global barrier : the sends are completed by waitall, and all the receptions have been completed above
     int nPatchSend(send_patch_id_.size());
-    for (int ipatch=nPatchSend-1 ; ipatch>=0 ; ipatch--) {
-        //Ok while at least 1 old patch stay inon current CPU
+    for (int ipatch=0 ; ipatch<nPatchSend ; ipatch++) {
+        smpi->waitall( (*this)(send_patch_id_[ipatch]) );
         delete (*this)(send_patch_id_[ipatch]);
         patches_[ send_patch_id_[ipatch] ] = NULL;
-        patches_.erase( patches_.begin() + send_patch_id_[ipatch] );
-        
     }
 
-
-    //Put received patches in the global vecPatches
-    for (unsigned int ipatch=0 ; ipatch<recv_patch_id_.size() ; ipatch++) {
-        if ( recv_patch_id_[ipatch] > refHindex_ )
-            patches_.push_back( recv_patches_[ipatch] );
-        else
-            patches_.insert( patches_.begin()+ipatch, recv_patches_[ipatch] );
-    }
+    //Put received patches in the global vecPatches, in a single pass over the patches kept
+    //  - patches received from the previous MPI process first, those from the next one last
+    vector<Patch*> new_patches;
+    new_patches.reserve( patches_.size() - nPatchSend + recv_patches_.size() );
+    unsigned int irecv = 0;
+    while ( irecv<recv_patch_id_.size() && recv_patch_id_[irecv] <= refHindex_ )
+        new_patches.push_back( recv_patches_[irecv++] );
+    for (unsigned int ipatch=0 ; ipatch<patches_.size() ; ipatch++)
+        if ( patches_[ipatch] ) new_patches.push_back( patches_[ipatch] );
+    while ( irecv<recv_patch_id_.size() )
+        new_patches.push_back( recv_patches_[irecv++] );
+    patches_.swap( new_patches );
     recv_patches_.clear();
 
     
+    // Window sized for the new number of patches, before the patches compute their slots
+    smpi->allocateGhostWindow( params );
     for (unsigned int ipatch=0 ; ipatch<patches_.size() ; ipatch++ ) { 
         (*this)(ipatch)->updateMPIenv(smpi);
         if ((*this)(ipatch)->has_an_MPI_neighbor())
@@ -817,6 +1126,8 @@ void VectorPatch::exchangePatches(SmileiMPI* smpi, Params& params)
          else
             (*this)(ipatch)->cleanType();
     }
+    // Processes owning the new neighbor patches
+    smpi->createNeighborhood( *this );
     (*this).set_refHindex() ;
     update_field_list() ;    
 
@@ -1136,9 +1447,12 @@ void VectorPatch::applyCollisions(Params& params, int itime, Timers & timers)
     unsigned int ncoll = patches_[0]->vecCollisions.size();
     
     #pragma omp for schedule(static)
-    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++)
+    for (unsigned int ipatch=0 ; ipatch<size() ; ipatch++) {
+        double start = MPI_Wtime();
         for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
             patches_[ipatch]->vecCollisions[icoll]->collide(params,patches_[ipatch],itime, localDiags);
+        patches_[ipatch]->addMeasuredLoad( MPI_Wtime()-start );
+    }
     
     #pragma omp single
     for (unsigned int icoll=0 ; icoll<ncoll; icoll++)
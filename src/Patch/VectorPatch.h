@@ -2,6 +2,7 @@
 #define VECTORPATCH_H
 
 #include <vector>
+#include <map>
 #include <iostream>
 #include <cstdlib>
 #include <iomanip>
@@ -89,6 +90,10 @@ public :
     //! For all patch, move particles (restartRhoJ(s), dynamics and exchangeParticles)
     void dynamics(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual,
                   Timers &timers, int itime);
+    //! Same as dynamics, with the bins of the patches distributed among the threads (see tiled_currents)
+    void dynamicsTiled(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual);
+    //! Same as dynamics, with the bins of the heaviest patches processed as OpenMP tasks (see heavy_patch_factor)
+    void dynamicsHeavyPatches(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual);
     void finalize_and_sort_parts(Params& params, SmileiMPI* smpi, SimWindow* simWindow, double time_dual,
                   Timers &timers, int itime);
 
@@ -99,7 +104,7 @@ public :
     void sumDensities(Params &params, double time_dual, Timers &timers, int itime, SimWindow* simWindow );
     
     //! For all patch, update E and B (Ampere, Faraday, boundary conditions, exchange B and center B)
-    void solveMaxwell(Params& params, SimWindow* simWindow, int itime, double time_dual,
+    void solveMaxwell(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual,
                       Timers & timers);
     
     //! For all patch, Compute and Write all diags (Scalars, Probes, Phases, TrackParticles, Fields, Average fields)
@@ -130,7 +135,7 @@ public :
     // ------------------
     
     //! Wrapper of load balancing methods, including SmileiMPI::recompute_patch_count. Called from main program
-    void load_balance(Params& params, double time_dual, SmileiMPI* smpi, SimWindow* simWindow, unsigned int itime);
+    void load_balance(Params& params, double time_dual, SmileiMPI* smpi, SimWindow* simWindow, unsigned int itime, bool node_only=false);
     
     //! Explicits patch movement regarding new patch distribution stored in smpi->patch_count
     void createPatches(Params& params, SmileiMPI* smpi, SimWindow* simWindow);
@@ -212,6 +217,21 @@ public :
     // Keep track if we need the needsRhoJsNow
     int diag_flag;
     
+    //! Bins ibin_min to ibin_max-1 of species ispec in patch ipatch, processed by one thread (see tiled_currents)
+    struct TiledTask {
+        unsigned int ipatch, ispec, ibin_min, ibin_max;
+    };
+    //! List of the tasks of the current timestep when tiled_currents is used
+    std::vector<TiledTask> tiled_tasks;
+    
+    //! Patches whose bins are processed as OpenMP tasks at the current timestep (see heavy_patch_factor)
+    std::vector<bool> is_heavy;
+    
+    //! Packed particles sent to each MPI process, per direction (see aggregate_particle_messages)
+    std::map<int, std::vector<char> > rank_send_buffers[2];
+    //! Packed particles received from an MPI process
+    std::vector<char> rank_recv_buffer;
+    
     int nrequests;
     
     //! Tells which iteration was last time the patches moved (by moving window or load balancing)
@@ -238,6 +258,13 @@ public :
         return (*this)(ipatch)->Proj;
     }
     
+    //! True if the species ispec of patch ipatch is moving, projected, and may be processed bin by bin as tasks
+    inline bool isSplittable(int ipatch, int ispec, double time_dual, SimWindow* simWindow) {
+        Species* spec = species(ipatch, ispec);
+        return ( spec->isProj(time_dual, simWindow) || diag_flag )
+            && time_dual > spec->time_frozen && !spec->Ionize;
+    }
+    
     inline PartWalls* partwalls(int ipatch){
         return (*this)(ipatch)->partWalls;
     }
@@ -252,6 +279,19 @@ public :
     //! Current intensity of antennas
     double antenna_intensity;
     
+    //  Temporal blocking members (temporal_blocking > 1)
+    // --------------------------------------------------
+    //! True if the current timestep belongs to a vacuum block : no particle in the simulation, no exchange
+    bool vacuum_block_;
+    //! Number of timesteps since the beginning of the current vacuum block
+    unsigned int vacuum_steps_;
+    
+    //! True if the patches move at the end of this timestep (moving window, load balancing)
+    bool patchesMove(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual);
+    //! True if the ghost cells of E and B are exchanged at the end of this timestep of a vacuum block
+    bool vacuumBlockEnds(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual);
+    //! Starts, continues or ends the vacuum block, once the fields are advanced
+    void updateVacuumBlock(Params& params, SmileiMPI* smpi, SimWindow* simWindow, int itime, double time_dual);
     
 };
 
@@ -32,6 +32,12 @@ public:
 
    //!Wrapper
     virtual void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec) = 0;
+
+    //! Project the current densities (and rho if not NULL) of particles istart to iend of bin ibin in the bin buffers b_J*
+    //! (thread-private tiles with the same layout as the fields, starting at the first row of the bin)
+    virtual void operator() (double* b_Jx, double* b_Jy, double* b_Jz, double* b_rho, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim) {
+        ERROR("Projection in bin buffers not available for this projector");
+    }
 private:
 
 };
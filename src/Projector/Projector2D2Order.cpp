@@ -450,6 +450,196 @@ void Projector2D2Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &
 
 
 // ---------------------------------------------------------------------------------------------------------------------
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities of a range of particles (Esirkepov scheme, vectorized version)
+//! Shape functions are computed for vecSize particles at once, then the particles sharing
+//! the same former cell are reduced in a private 5x5 stencil which is added once to the grid
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector2D2Order::currents(double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, int istart, int iend, double* invgf, int* iold, double* deltaold, unsigned int bin, std::vector<unsigned int> &b_dim)
+{
+    double* position_x = &( particles.position(0,0) );
+    double* position_y = &( particles.position(1,0) );
+    particle_real* momentum_z = &( particles.momentum(2,0) );
+    particle_real* weight     = &( particles.weight(0) );
+    short*  charge     = &( particles.charge(0) );
+    
+    // Positions relative to the nearest primal node, stored for the interpolation at the next time step
+    bool relative = particles.relative_positions;
+    double* cell_x   = relative ? particles.Cell  [0].data() : NULL;
+    double* cell_y   = relative ? particles.Cell  [1].data() : NULL;
+    double* offset_x = relative ? particles.Offset[0].data() : NULL;
+    double* offset_y = relative ? particles.Offset[1].data() : NULL;
+    
+    // Shape functions of a block of particles, [stencil point][particle]
+    double Sx0[5][vecSize], Sx1[5][vecSize], Sy0[5][vecSize], Sy1[5][vecSize], DSx[5][vecSize], DSy[5][vecSize];
+    double charge_weight[vecSize], crz_p[vecSize], tmpJ[vecSize];
+    // Currents of the particles sharing the same former cell
+    double bJx[5][5], bJy[5][5], bJz[5][5], brho[5][5];
+    
+    for ( int ivect=istart ; ivect<iend ; ivect+=vecSize ) {
+        int np = min( vecSize, iend-ivect );
+        
+        #pragma omp simd
+        for ( int ipart=0 ; ipart<np ; ipart++ ) {
+            int jpart = ivect+ipart;
+            charge_weight[ipart] = (double)(charge[jpart])*weight[jpart];
+            crz_p[ipart] = charge_weight[ipart]*momentum_z[jpart]*invgf[jpart];
+            
+            // coeff. at former time-step
+            double delta  = deltaold[2*jpart];
+            double delta2 = delta*delta;
+            Sx0[0][ipart] = 0.;
+            Sx0[1][ipart] = 0.5 * (delta2-delta+0.25);
+            Sx0[2][ipart] = 0.75-delta2;
+            Sx0[3][ipart] = 0.5 * (delta2+delta+0.25);
+            Sx0[4][ipart] = 0.;
+            
+            delta  = deltaold[2*jpart+1];
+            delta2 = delta*delta;
+            Sy0[0][ipart] = 0.;
+            Sy0[1][ipart] = 0.5 * (delta2-delta+0.25);
+            Sy0[2][ipart] = 0.75-delta2;
+            Sy0[3][ipart] = 0.5 * (delta2+delta+0.25);
+            Sy0[4][ipart] = 0.;
+            
+            // coeff. at current time-step, shifted by the cell displacement (-1, 0 or +1) without branching
+            double xpn = position_x[jpart] * dx_inv_;
+            double xp  = round(xpn);
+            double ip_m_ipo = xp - (double)(iold[2*jpart] + i_domain_begin);
+            delta  = xpn - xp;
+            delta2 = delta*delta;
+            if ( relative ) {
+                cell_x  [jpart] = xp;
+                offset_x[jpart] = delta;
+            }
+            double m1 = 0.5 * (delta2-delta+0.25);
+            double c0 = 0.75-delta2;
+            double p1 = 0.5 * (delta2+delta+0.25);
+            double cm = (double)(ip_m_ipo==-1.);
+            double cz = (double)(ip_m_ipo== 0.);
+            double cp = (double)(ip_m_ipo== 1.);
+            Sx1[0][ipart] = cm*m1;
+            Sx1[1][ipart] = cm*c0 + cz*m1;
+            Sx1[2][ipart] = cm*p1 + cz*c0 + cp*m1;
+            Sx1[3][ipart] =         cz*p1 + cp*c0;
+            Sx1[4][ipart] =                 cp*p1;
+            
+            double ypn = position_y[jpart] * dy_inv_;
+            double yp  = round(ypn);
+            double jp_m_jpo = yp - (double)(iold[2*jpart+1] + j_domain_begin);
+            delta  = ypn - yp;
+            delta2 = delta*delta;
+            if ( relative ) {
+                cell_y  [jpart] = yp;
+                offset_y[jpart] = delta;
+            }
+            m1 = 0.5 * (delta2-delta+0.25);
+            c0 = 0.75-delta2;
+            p1 = 0.5 * (delta2+delta+0.25);
+            cm = (double)(jp_m_jpo==-1.);
+            cz = (double)(jp_m_jpo== 0.);
+            cp = (double)(jp_m_jpo== 1.);
+            Sy1[0][ipart] = cm*m1;
+            Sy1[1][ipart] = cm*c0 + cz*m1;
+            Sy1[2][ipart] = cm*p1 + cz*c0 + cp*m1;
+            Sy1[3][ipart] =         cz*p1 + cp*c0;
+            Sy1[4][ipart] =                 cp*p1;
+            
+            for ( int i=0 ; i<5 ; i++ ) {
+                DSx[i][ipart] = Sx1[i][ipart] - Sx0[i][ipart];
+                DSy[i][ipart] = Sy1[i][ipart] - Sy0[i][ipart];
+            }
+        }
+        
+        // Deposit the block by groups of consecutive particles coming from the same cell
+        int ip0 = 0;
+        while ( ip0<np ) {
+            int ipo = iold[2*(ivect+ip0)  ];
+            int jpo = iold[2*(ivect+ip0)+1];
+            int ip1 = ip0+1;
+            while ( ip1<np && iold[2*(ivect+ip1)]==ipo && iold[2*(ivect+ip1)+1]==jpo )
+                ip1++;
+            
+            // Jx^(d,p) : cumulative sum along x
+            for ( int j=0 ; j<5 ; j++ ) {
+                #pragma omp simd
+                for ( int ipart=ip0 ; ipart<ip1 ; ipart++ )
+                    tmpJ[ipart] = 0.;
+                bJx[0][j] = 0.;
+                for ( int i=1 ; i<5 ; i++ ) {
+                    double sum = 0.;
+                    #pragma omp simd reduction(+:sum)
+                    for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                        tmpJ[ipart] -= charge_weight[ipart]*dx_ov_dt * DSx[i-1][ipart] * (Sy0[j][ipart] + 0.5*DSy[j][ipart]);
+                        sum += tmpJ[ipart];
+                    }
+                    bJx[i][j] = sum;
+                }
+            }
+            
+            // Jy^(p,d) : cumulative sum along y
+            for ( int i=0 ; i<5 ; i++ ) {
+                #pragma omp simd
+                for ( int ipart=ip0 ; ipart<ip1 ; ipart++ )
+                    tmpJ[ipart] = 0.;
+                bJy[i][0] = 0.;
+                for ( int j=1 ; j<5 ; j++ ) {
+                    double sum = 0.;
+                    #pragma omp simd reduction(+:sum)
+                    for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                        tmpJ[ipart] -= charge_weight[ipart]*dy_ov_dt * DSy[j-1][ipart] * (Sx0[i][ipart] + 0.5*DSx[i][ipart]);
+                        sum += tmpJ[ipart];
+                    }
+                    bJy[i][j] = sum;
+                }
+            }
+            
+            // Jz^(p,p) (and rho^(p,p))
+            for ( int i=0 ; i<5 ; i++ ) {
+                for ( int j=0 ; j<5 ; j++ ) {
+                    double sum = 0.;
+                    #pragma omp simd reduction(+:sum)
+                    for ( int ipart=ip0 ; ipart<ip1 ; ipart++ )
+                        sum += crz_p[ipart] * one_third * ( Sy0[j][ipart]*(0.5*Sx1[i][ipart]+Sx0[i][ipart])
+                                                          + Sy1[j][ipart]*(0.5*Sx0[i][ipart]+Sx1[i][ipart]) );
+                    bJz[i][j] = sum;
+                }
+            }
+            if ( rho ) {
+                for ( int i=0 ; i<5 ; i++ ) {
+                    for ( int j=0 ; j<5 ; j++ ) {
+                        double sum = 0.;
+                        #pragma omp simd reduction(+:sum)
+                        for ( int ipart=ip0 ; ipart<ip1 ; ipart++ )
+                            sum += charge_weight[ipart] * Sx1[i][ipart]*Sy1[j][ipart];
+                        brho[i][j] = sum;
+                    }
+                }
+            }
+            
+            // Add the stencil to the bin arrays
+            ipo -= bin+2;
+            jpo -= 2;
+            for ( int i=0 ; i<5 ; i++ ) {
+                int iloc  = (i+ipo)*b_dim[1]+jpo;
+                int ilocy = (i+ipo)*(b_dim[1]+1)+jpo;
+                for ( int j=0 ; j<5 ; j++ ) {
+                    Jx[iloc +j] += bJx[i][j];
+                    Jy[ilocy+j] += bJy[i][j];
+                    Jz[iloc +j] += bJz[i][j];
+                }
+                if ( rho ) {
+                    for ( int j=0 ; j<5 ; j++ )
+                        rho[iloc+j] += brho[i][j];
+                }
+            }
+            
+            ip0 = ip1;
+        }
+    }
+}
+
+
 //! Wrapper for projection
 // ---------------------------------------------------------------------------------------------------------------------
 void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
@@ -465,8 +655,7 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw*dim1);
         double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1));
         double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw*dim1);
-        for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[2*ipart], &(*delta)[2*ipart]);
+        currents(b_Jx , b_Jy , b_Jz , NULL, particles, istart, iend, &(*invgf)[0], &(*iold)[0], &(*delta)[0], ibin*clrw, b_dim);
             
     // Otherwise, the projection may apply to the species-specific arrays
     } else {
@@ -474,7 +663,13 @@ void Projector2D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)) ;
         double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw* dim1   ) : &(*EMfields->Jz_ )(ibin*clrw* dim1   ) ;
         double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   ) : &(*EMfields->rho_)(ibin*clrw* dim1   ) ;
-        for (int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[2*ipart], &(*delta)[2*ipart]);
+        currents(b_Jx , b_Jy , b_Jz , b_rho, particles, istart, iend, &(*invgf)[0], &(*iold)[0], &(*delta)[0], ibin*clrw, b_dim);
     }
 }
+
+
+// Wrapper projecting in bin buffers
+void Projector2D2Order::operator() (double* b_Jx, double* b_Jy, double* b_Jz, double* b_rho, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim)
+{
+    currents(b_Jx , b_Jy , b_Jz , b_rho, particles, istart, iend, &(smpi->dynamics_invgf[ithread][0]), &(smpi->dynamics_iold[ithread][0]), &(smpi->dynamics_deltaold[ithread][0]), ibin*clrw, b_dim);
+}
@@ -14,6 +14,9 @@ public:
     //! Project global current densities (EMfields->Jx_/Jy_/Jz_/rho), diagFields timestep
     inline void operator() (double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, unsigned int ipart, double invgf, unsigned int bin, std::vector<unsigned int> &b_dim, int* iold, double* deltaold);
 
+    //! Project global current densities (and rho if not NULL) of particles istart to iend, vecSize particles at a time
+    void currents(double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, int istart, int iend, double* invgf, int* iold, double* deltaold, unsigned int bin, std::vector<unsigned int> &b_dim);
+
     //! Project global current charge (EMfields->rho_), frozen & diagFields timestep
     void operator() (double* rho, Particles &particles, unsigned int ipart, unsigned int bin, std::vector<unsigned int> &b_dim) override final;
 
@@ -23,8 +26,13 @@ public:
     //!Wrapper
     void operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec) override final;
 
+    //! Wrapper projecting in bin buffers (see Species::dynamicsTiled)
+    void operator() (double* b_Jx, double* b_Jy, double* b_Jz, double* b_rho, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim) override final;
+
 private:
     double one_third;
+    //! Number of particles whose shape functions are computed together in currents()
+    static const int vecSize = 8;
 };
 
 #endif
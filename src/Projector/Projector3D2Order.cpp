@@ -681,6 +681,174 @@ void Projector3D2Order::operator() (Field* Jx, Field* Jy, Field* Jz, Particles &
 
 } // END Project global current densities (ionize)
 
+// ---------------------------------------------------------------------------------------------------------------------
+//! Project current densities of a range of particles (Esirkepov scheme, vectorized version)
+//! Shape functions are computed for vecSize particles at once, then the particles sharing
+//! the same former cell are reduced in a private 5x5x5 stencil which is added once to the grid
+// ---------------------------------------------------------------------------------------------------------------------
+void Projector3D2Order::currents(double* Jx, double* Jy, double* Jz, double* rho, Particles &particles, int istart, int iend, double* invgf, int* iold, double* deltaold, unsigned int bin, std::vector<unsigned int> &b_dim)
+{
+    double* position[3];
+    for ( int idim=0 ; idim<3 ; idim++ )
+        position[idim] = &( particles.position(idim,0) );
+    particle_real* weight = &( particles.weight(0) );
+    short*  charge = &( particles.charge(0) );
+    double inv_cell[3] = { dx_inv_, dy_inv_, dz_inv_ };
+    int domain_begin[3] = { i_domain_begin, j_domain_begin, k_domain_begin };
+    
+    // Positions relative to the nearest primal node, stored for the interpolation at the next time step
+    bool relative = particles.relative_positions;
+    double* cell  [3] = { NULL, NULL, NULL };
+    double* offset[3] = { NULL, NULL, NULL };
+    if ( relative ) {
+        for ( int idim=0 ; idim<3 ; idim++ ) {
+            cell  [idim] = particles.Cell  [idim].data();
+            offset[idim] = particles.Offset[idim].data();
+        }
+    }
+    
+    // Shape functions of a block of particles, [dimension][stencil point][particle]
+    double S0[3][5][vecSize], S1[3][5][vecSize], DS[3][5][vecSize];
+    double charge_weight[vecSize], tmpW[vecSize], tmpJ[vecSize];
+    // Currents of the particles sharing the same former cell
+    double bJx[5][5][5], bJy[5][5][5], bJz[5][5][5], brho[5][5][5];
+    
+    for ( int ivect=istart ; ivect<iend ; ivect+=vecSize ) {
+        int np = min( vecSize, iend-ivect );
+        
+        for ( int idim=0 ; idim<3 ; idim++ ) {
+            #pragma omp simd
+            for ( int ipart=0 ; ipart<np ; ipart++ ) {
+                int jpart = ivect+ipart;
+                
+                // coeff. at former time-step
+                double delta  = deltaold[3*jpart+idim];
+                double delta2 = delta*delta;
+                S0[idim][0][ipart] = 0.;
+                S0[idim][1][ipart] = 0.5 * (delta2-delta+0.25);
+                S0[idim][2][ipart] = 0.75-delta2;
+                S0[idim][3][ipart] = 0.5 * (delta2+delta+0.25);
+                S0[idim][4][ipart] = 0.;
+                
+                // coeff. at current time-step, shifted by the cell displacement (-1, 0 or +1) without branching
+                double xpn = position[idim][jpart] * inv_cell[idim];
+                double xp  = round(xpn);
+                double ip_m_ipo = xp - (double)(iold[3*jpart+idim] + domain_begin[idim]);
+                delta  = xpn - xp;
+                delta2 = delta*delta;
+                if ( relative ) {
+                    cell  [idim][jpart] = xp;
+                    offset[idim][jpart] = delta;
+                }
+                double m1 = 0.5 * (delta2-delta+0.25);
+                double c0 = 0.75-delta2;
+                double p1 = 0.5 * (delta2+delta+0.25);
+                double cm = (double)(ip_m_ipo==-1.);
+                double cz = (double)(ip_m_ipo== 0.);
+                double cp = (double)(ip_m_ipo== 1.);
+                S1[idim][0][ipart] = cm*m1;
+                S1[idim][1][ipart] = cm*c0 + cz*m1;
+                S1[idim][2][ipart] = cm*p1 + cz*c0 + cp*m1;
+                S1[idim][3][ipart] =         cz*p1 + cp*c0;
+                S1[idim][4][ipart] =                 cp*p1;
+                
+                for ( int i=0 ; i<5 ; i++ )
+                    DS[idim][i][ipart] = S1[idim][i][ipart] - S0[idim][i][ipart];
+            }
+        }
+        #pragma omp simd
+        for ( int ipart=0 ; ipart<np ; ipart++ )
+            charge_weight[ipart] = (double)(charge[ivect+ipart])*weight[ivect+ipart];
+        
+        // Deposit the block by groups of consecutive particles coming from the same cell
+        int ip0 = 0;
+        while ( ip0<np ) {
+            int ipo = iold[3*(ivect+ip0)  ];
+            int jpo = iold[3*(ivect+ip0)+1];
+            int kpo = iold[3*(ivect+ip0)+2];
+            int ip1 = ip0+1;
+            while ( ip1<np && iold[3*(ivect+ip1)]==ipo && iold[3*(ivect+ip1)+1]==jpo && iold[3*(ivect+ip1)+2]==kpo )
+                ip1++;
+            
+            // Each component is a cumulative sum along its own direction of the Esirkepov weights
+            // (d: cumulated direction, t1 and t2: transverse directions)
+            for ( int d=0 ; d<3 ; d++ ) {
+                int t1 = (d+1)%3;
+                int t2 = (d+2)%3;
+                double cr = (d==0 ? dx_ov_dt : (d==1 ? dy_ov_dt : dz_ov_dt));
+                double (*bJ)[5][5] = (d==0 ? bJx : (d==1 ? bJy : bJz));
+                for ( int m=0 ; m<5 ; m++ ) {
+                    for ( int n=0 ; n<5 ; n++ ) {
+                        #pragma omp simd
+                        for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                            tmpW[ipart] = charge_weight[ipart]*cr * ( S0[t1][m][ipart]*S0[t2][n][ipart]
+                                                                    + 0.5*DS[t1][m][ipart]*S0[t2][n][ipart]
+                                                                    + 0.5*S0[t1][m][ipart]*DS[t2][n][ipart]
+                                                                    + one_third*DS[t1][m][ipart]*DS[t2][n][ipart] );
+                            tmpJ[ipart] = 0.;
+                        }
+                        double* stencil[5];
+                        for ( int l=0 ; l<5 ; l++ ) {
+                            // bJ is stored [i][j][k], (l,m,n) are the (d,t1,t2) indices
+                            int ijk[3];
+                            ijk[d] = l; ijk[t1] = m; ijk[t2] = n;
+                            stencil[l] = &bJ[ijk[0]][ijk[1]][ijk[2]];
+                        }
+                        *stencil[0] = 0.;
+                        for ( int l=1 ; l<5 ; l++ ) {
+                            double sum = 0.;
+                            #pragma omp simd reduction(+:sum)
+                            for ( int ipart=ip0 ; ipart<ip1 ; ipart++ ) {
+                                tmpJ[ipart] -= DS[d][l-1][ipart] * tmpW[ipart];
+                                sum += tmpJ[ipart];
+                            }
+                            *stencil[l] = sum;
+                        }
+                    }
+                }
+            }
+            
+            if ( rho ) {
+                for ( int i=0 ; i<5 ; i++ ) {
+                    for ( int j=0 ; j<5 ; j++ ) {
+                        for ( int k=0 ; k<5 ; k++ ) {
+                            double sum = 0.;
+                            #pragma omp simd reduction(+:sum)
+                            for ( int ipart=ip0 ; ipart<ip1 ; ipart++ )
+                                sum += charge_weight[ipart] * S1[0][i][ipart]*S1[1][j][ipart]*S1[2][k][ipart];
+                            brho[i][j][k] = sum;
+                        }
+                    }
+                }
+            }
+            
+            // Add the stencil to the bin arrays
+            ipo -= bin+2;
+            jpo -= 2;
+            kpo -= 2;
+            for ( int i=0 ; i<5 ; i++ ) {
+                for ( int j=0 ; j<5 ; j++ ) {
+                    int iloc  = ((i+ipo)* b_dim[1]   +j+jpo)* b_dim[2]   +kpo;
+                    int ilocy = ((i+ipo)*(b_dim[1]+1)+j+jpo)* b_dim[2]   +kpo;
+                    int ilocz = ((i+ipo)* b_dim[1]   +j+jpo)*(b_dim[2]+1)+kpo;
+                    for ( int k=0 ; k<5 ; k++ ) {
+                        Jx[iloc +k] += bJx[i][j][k];
+                        Jy[ilocy+k] += bJy[i][j][k];
+                        Jz[ilocz+k] += bJz[i][j][k];
+                    }
+                    if ( rho ) {
+                        for ( int k=0 ; k<5 ; k++ )
+                            rho[iloc+k] += brho[i][j][k];
+                    }
+                }
+            }
+            
+            ip0 = ip1;
+        }
+    }
+}
+
+
 //Wrapper for projection
 void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, bool diag_flag, std::vector<unsigned int> &b_dim, int ispec)
 {
@@ -696,8 +864,7 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jx =  &(*EMfields->Jx_ )(ibin*clrw* dim1   * dim2   );
         double* b_Jy =  &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)* dim2   );
         double* b_Jz =  &(*EMfields->Jz_ )(ibin*clrw* dim1   *(dim2+1));
-        for ( int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz , particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[3*ipart], &(*delta)[3*ipart]);
+        currents(b_Jx , b_Jy , b_Jz , NULL, particles, istart, iend, &(*invgf)[0], &(*iold)[0], &(*delta)[0], ibin*clrw, b_dim);
             
     // Otherwise, the projection may apply to the species-specific arrays
     } else {
@@ -705,8 +872,14 @@ void Projector3D2Order::operator() (ElectroMagn* EMfields, Particles &particles,
         double* b_Jy  = EMfields->Jy_s [ispec] ? &(*EMfields->Jy_s [ispec])(ibin*clrw*(dim1+1)*dim2) : &(*EMfields->Jy_ )(ibin*clrw*(dim1+1)*dim2) ;
         double* b_Jz  = EMfields->Jz_s [ispec] ? &(*EMfields->Jz_s [ispec])(ibin*clrw*dim1*(dim2+1)) : &(*EMfields->Jz_ )(ibin*clrw*dim1*(dim2+1)) ;
         double* b_rho = EMfields->rho_s[ispec] ? &(*EMfields->rho_s[ispec])(ibin*clrw* dim1   *dim2) : &(*EMfields->rho_)(ibin*clrw* dim1   *dim2) ;
-        for ( int ipart=istart ; ipart<iend; ipart++ )
-            (*this)(b_Jx , b_Jy , b_Jz ,b_rho, particles,  ipart, (*invgf)[ipart], ibin*clrw, b_dim, &(*iold)[3*ipart], &(*delta)[3*ipart]);
+        currents(b_Jx , b_Jy , b_Jz , b_rho, particles, istart, iend, &(*invgf)[0], &(*iold)[0], &(*delta)[0], ibin*clrw, b_dim);
     }
 
 }
+
+
+// Wrapper projecting in bin buffers
+void Projector3D2Order::operator() (double* b_Jx, double* b_Jy, double* b_Jz, double* b_rho, Particles &particles, SmileiMPI* smpi, int istart, int iend, int ithread, int ibin, int clrw, std::vector<unsigned int> &b_dim)
+{
+    currents(b_Jx , b_Jy , b_Jz , b_rho, particles, istart, iend, &(smpi->dynamics_invgf[ithread][0]), &(smpi->dynamics_iold[ithread][0]), &(smpi->dynamics_deltaold[ithread][0]), ibin*clrw, b_dim);
+}
@@ -124,6 +124,16 @@ class Main(SmileiSingleton):
     interpolation_order = 2
     number_of_patches = None
     clrw = 1
+    tiled_currents = False
+    heavy_patch_factor = 0.
+    aggregate_particle_messages = False
+    single_round_particle_exchange = False
+    shared_memory_ghosts = False
+    persistent_requests = False
+    neighborhood_collectives = False
+    field_arena = False
+    skip_vacuum_patches = False
+    temporal_blocking = 1
     every_clean_particles_overhead = 100
     timestep = None
     timestep_over_CFL = None
@@ -142,6 +152,8 @@ class Main(SmileiSingleton):
     currentFilter_int = 0
     Friedman_filter = False
     Friedman_theta = 0.
+    psatd_guard_cells = 8
+    psatd_order = 8
     
     # Default Misc
     referenceAngularFrequency_SI = 0.
@@ -158,8 +170,8 @@ class Main(SmileiSingleton):
                 if Main.cell_length is None:
                     raise Exception("Need cell_length to calculate timestep")
                 
-                # Yee solver
-                if Main.maxwell_sol == 'Yee':
+                # Yee solver, and spectral solver (timestep relative to the Yee CFL condition)
+                if Main.maxwell_sol in ['Yee', 'PSATD']:
                     dim = int(Main.geometry[0])
                     if dim<1 or dim>3:
                         raise Exception("timestep_over_CFL not implemented in geometry "+Main.geometry)
@@ -203,9 +215,11 @@ class LoadBalancing(SmileiSingleton):
     """Load balancing parameters"""
     
     every = 150
+    node_every = 0
     initial_balance = True
     coef_cell = 1.0
     coef_frozen = 0.1
+    coef_measured = 0.
 
 
 class MovingWindow(SmileiSingleton):
@@ -245,6 +259,9 @@ class Species(SmileiComponent):
     thermT = None
     thermVelocity = None
     dynamics_type = "norm"
+    dynamics_chunk_size = 0
+    cell_sorting = False
+    relative_positions = False
     time_frozen = 0.0
     radiating = False
     bc_part_type_xmin = None
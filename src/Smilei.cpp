@@ -207,7 +207,7 @@ int main (int argc, char* argv[])
             
             // solve Maxwell's equations
             if( time_dual > params.time_fields_frozen )
-                vecPatches.solveMaxwell( params, simWindow, itime, time_dual, timers );
+                vecPatches.solveMaxwell( params, smpi, simWindow, itime, time_dual, timers );
 
             vecPatches.finalize_and_sort_parts(params, smpi, simWindow, time_dual, timers, itime);
 
@@ -234,6 +234,13 @@ int main (int argc, char* argv[])
                     vecPatches.load_balance( params, time_dual, smpi, simWindow, itime );
                     timers.loadBal.update( params.printNow( itime ) );
                 }
+                // Cheaper balancing inside the nodes only, in between
+                else if ( ( params.node_balancing_every > 0 ) && ( itime%params.node_balancing_every == 0 ) && smpi->nodeBalancing() ) {
+                    timers.loadBal.restart();
+                    #pragma omp single
+                    vecPatches.load_balance( params, time_dual, smpi, simWindow, itime, true );
+                    timers.loadBal.update( params.printNow( itime ) );
+                }
             }
         
             // print message at given time-steps
@@ -258,6 +265,7 @@ int main (int argc, char* argv[])
     
     TITLE("Time profiling : (print time > 0.001%)");
     timers.profile(smpi);
+    smpi->neighborhoodVolume();
     
 /*tommaso
     // ------------------------------------------------------------------
@@ -2,17 +2,34 @@
 #include "AsyncMPIbuffers.h"
 #include "Field.h"
 #include "Patch.h"
+#include "NeighborhoodExchange.h"
 
 #include <vector>
 using namespace std;
 
 AsyncMPIbuffers::AsyncMPIbuffers()
 {
+    pkind_ = -1;
+    pcreate_ = false;
+    neighborhood_ = NULL;
+    tagp_ = 0;
 }
 
 
 AsyncMPIbuffers::~AsyncMPIbuffers()
 {
+    int finalized;
+    MPI_Finalized( &finalized );
+    if ( finalized ) return;
+    
+    for (int kind=0 ; kind<2 ; kind++)
+        for (unsigned int iDim=0 ; iDim<psrequest[kind].size() ; iDim++)
+            for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+                if ( psrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL )
+                    MPI_Request_free( &(psrequest[kind][iDim][iNeighbor]) );
+                if ( prrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL )
+                    MPI_Request_free( &(prrequest[kind][iDim][iNeighbor]) );
+            }
 }
 
 
@@ -86,6 +103,7 @@ void AsyncMPIbuffers::allocate(unsigned int ndims, Field* f, std::vector<unsigne
 
 void AsyncMPIbuffers::defineTags(Patch* patch, int tag ) 
 {
+    tagp_ = tag;
     for (unsigned int iDim=0 ; iDim< send_tags_.size() ; iDim++)
         for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             send_tags_[iDim][iNeighbor] = buildtag( patch->hindex, iDim, iNeighbor, tag );
@@ -95,6 +113,102 @@ void AsyncMPIbuffers::defineTags(Patch* patch, int tag )
 }
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Persistent requests (MPI_Send_init/Recv_init), created at the first communication with the current neighbors of the
+// patch, then only started (MPI_Start) until the neighbors change (load balancing, moving window)
+// ---------------------------------------------------------------------------------------------------------------------
+void AsyncMPIbuffers::initRequests( int kind, int iDim, Patch* patch )
+{
+    neighborhood_ = patch->neighborhood();
+    if ( neighborhood_ ) {
+        pkind_ = -1;
+        return;
+    }
+    startPersistent( kind, iDim, patch->requestsEpoch(), patch );
+
+} // END initRequests
+
+
+void AsyncMPIbuffers::startPersistent( int kind, int iDim, int epoch, Patch* patch )
+{
+    pkind_ = -1;
+    if ( epoch < 0 ) return;
+    
+    pkind_ = kind;
+    if ( pepoch[kind].size() == 0 ) {
+        unsigned int ndims = srequest.size();
+        psrequest[kind].resize( ndims );
+        prrequest[kind].resize( ndims );
+        for (unsigned int i=0 ; i<ndims ; i++) {
+            psrequest[kind][i].resize( 2, MPI_REQUEST_NULL );
+            prrequest[kind][i].resize( 2, MPI_REQUEST_NULL );
+        }
+        pepoch[kind].resize( ndims, -1 );
+    }
+    
+    if ( pepoch[kind][iDim] == epoch ) {
+        pcreate_ = false;
+        for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+            if ( psrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL ) {
+                srequest[iDim][iNeighbor] = psrequest[kind][iDim][iNeighbor];
+                MPI_Start( &(srequest[iDim][iNeighbor]) );
+            }
+            if ( prrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL ) {
+                rrequest[iDim][iNeighbor] = prrequest[kind][iDim][iNeighbor];
+                MPI_Start( &(rrequest[iDim][iNeighbor]) );
+            }
+        }
+        return;
+    }
+    
+    // Neighbors changed : outdated requests freed, tags of the current neighbors
+    pcreate_ = true;
+    for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
+        if ( psrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL )
+            MPI_Request_free( &(psrequest[kind][iDim][iNeighbor]) );
+        if ( prrequest[kind][iDim][iNeighbor] != MPI_REQUEST_NULL )
+            MPI_Request_free( &(prrequest[kind][iDim][iNeighbor]) );
+    }
+    defineTags( patch, tagp_ );
+    pepoch[kind][iDim] = epoch;
+
+} // END startPersistent
+
+
+void AsyncMPIbuffers::isend( void* buf, int count, MPI_Datatype type, int dest, int tag, int iDim, int iNeighbor )
+{
+    if ( neighborhood_ ) {
+        neighborhood_->send( buf, count, type, dest, tag );
+        srequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+    }
+    else if ( pkind_ < 0 )
+        MPI_Isend( buf, count, type, dest, tag, MPI_COMM_WORLD, &(srequest[iDim][iNeighbor]) );
+    else if ( pcreate_ ) {
+        MPI_Send_init( buf, count, type, dest, tag, MPI_COMM_WORLD, &(psrequest[pkind_][iDim][iNeighbor]) );
+        srequest[iDim][iNeighbor] = psrequest[pkind_][iDim][iNeighbor];
+        MPI_Start( &(srequest[iDim][iNeighbor]) );
+    }
+
+} // END isend
+
+
+void AsyncMPIbuffers::irecv( void* buf, int count, MPI_Datatype type, int source, int tag, int iDim, int iNeighbor )
+{
+    if ( neighborhood_ ) {
+        neighborhood_->recv( buf, count, type, source, tag );
+        rrequest[iDim][iNeighbor] = MPI_REQUEST_NULL;
+    }
+    else if ( pkind_ < 0 )
+        MPI_Irecv( buf, count, type, source, tag, MPI_COMM_WORLD, &(rrequest[iDim][iNeighbor]) );
+    else if ( pcreate_ ) {
+        MPI_Recv_init( buf, count, type, source, tag, MPI_COMM_WORLD, &(prrequest[pkind_][iDim][iNeighbor]) );
+        rrequest[iDim][iNeighbor] = prrequest[pkind_][iDim][iNeighbor];
+        MPI_Start( &(rrequest[iDim][iNeighbor]) );
+    }
+
+} // END irecv
+
+
 SpeciesMPIbuffers::SpeciesMPIbuffers()
 {
 }
@@ -111,7 +225,8 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
     rrequest.resize(ndims);
 
     partRecv.resize(ndims);
-    partSend.resize(ndims);
+    bufferSend.resize(ndims);
+    bufferRecv.resize(ndims);
 
     part_index_send.resize(ndims);
     part_index_send_sz.resize(ndims);
@@ -121,11 +236,24 @@ void SpeciesMPIbuffers::allocate(unsigned int ndims)
         srequest[i].resize(2);
         rrequest[i].resize(2);
         partRecv[i].resize(2);
-        partSend[i].resize(2);
+        bufferSend[i].resize(2);
+        bufferRecv[i].resize(2);
         part_index_send[i].resize(2);
         part_index_send_sz[i].resize(2);
         part_index_recv_sz[i].resize(2);
     }
 
+    unsigned int nCornerNeighbors = 1;
+    for (unsigned int i=0 ; i<ndims ; i++)
+        nCornerNeighbors *= 3;
+    srequest_corner.resize(nCornerNeighbors);
+    rrequest_corner.resize(nCornerNeighbors);
+    partRecv_corner.resize(nCornerNeighbors);
+    bufferSend_corner.resize(nCornerNeighbors);
+    bufferRecv_corner.resize(nCornerNeighbors);
+    part_index_send_corner.resize(nCornerNeighbors);
+    part_index_send_sz_corner.resize(nCornerNeighbors, 0);
+    part_index_recv_sz_corner.resize(nCornerNeighbors, 0);
+
 }
 
@@ -8,6 +8,10 @@
 
 class Field;
 class Patch;
+class NeighborhoodExchange;
+
+//! Kinds of communications of a field with persistent requests (see Params::persistent_requests)
+enum { exchangeRequests = 0, sumRequests = 1 };
 
 class AsyncMPIbuffers {
 public:
@@ -19,6 +23,20 @@ public:
     virtual void allocate(unsigned int nDim_field, Field* f, std::vector<unsigned int>& oversize);
     void defineTags(Patch* patch, int tag ) ;
     
+    //! Before the communications of kind in direction iDim of the patch : messages posted to its neighborhood collective
+    //! if any (see Params::neighborhood_collectives), else persistent requests if used (see startPersistent)
+    void initRequests( int kind, int iDim, Patch* patch );
+    //! Start the persistent requests if they were created with
+    //! the current neighbors of the patch (epoch), else free them to be created by the next isend/irecv
+    //! epoch < 0 : no persistent requests, isend/irecv post MPI_Isend/Irecv
+    void startPersistent( int kind, int iDim, int epoch, Patch* patch );
+    //! MPI_Isend, or creation and start of the persistent request (nothing to do if already started),
+    //! or message posted to the neighborhood collective (request left null)
+    void isend( void* buf, int count, MPI_Datatype type, int dest, int tag, int iDim, int iNeighbor );
+    //! MPI_Irecv, or creation and start of the persistent request (nothing to do if already started),
+    //! or message posted to the neighborhood collective (request left null)
+    void irecv( void* buf, int count, MPI_Datatype type, int source, int tag, int iDim, int iNeighbor );
+    
     //! ndim vectors of 2 sent requests (1 per direction) 
     std::vector< std::vector<MPI_Request> > srequest;
     //! ndim vectors of 2 received requests (1 per direction) 
@@ -26,6 +44,22 @@ public:
     std::vector< double >  buf[3][2];
 
     std::vector< std::vector<int> > send_tags_, recv_tags_;
+    
+    //! Persistent sent and received requests per kind (exchange, sum), ndim vectors of 2 (1 per direction)
+    //! Started through copies in srequest and rrequest, so that the same MPI_Wait complete all requests
+    std::vector< std::vector<MPI_Request> > psrequest[2], prrequest[2];
+    //! Epoch of the patch neighbors when the persistent requests were created, per kind and dimension (-1 if not)
+    std::vector<int> pepoch[2];
+
+private:
+    //! Kind of the persistent requests used by isend/irecv, -1 for MPI_Isend/Irecv
+    int pkind_;
+    //! The persistent requests are being created by isend/irecv
+    bool pcreate_;
+    //! Neighborhood collective of the patch used by isend/irecv, NULL for point-to-point messages
+    NeighborhoodExchange* neighborhood_;
+    //! Tag of the field, to define again the tags of the current neighbors (see defineTags)
+    int tagp_;
 
 };
 
@@ -36,10 +70,13 @@ public:
 
     void allocate(unsigned int nDim_field) ;
 
-    //! ndim vectors of 2 sent packets of particles (1 per direction) 
-    std::vector< std::vector<Particles > > partRecv;
     //! ndim vectors of 2 received packets of particles (1 per direction) 
-    std::vector< std::vector<Particles > > partSend;
+    std::vector< std::vector<Particles > > partRecv;
+    
+    //! ndim vectors of 2 packed buffers of particles to send (1 per direction), kept from one exchange to the next
+    std::vector< std::vector< std::vector<char> > > bufferSend;
+    //! ndim vectors of 2 packed buffers of received particles (1 per direction), kept from one exchange to the next
+    std::vector< std::vector< std::vector<char> > > bufferRecv;
 
     //! ndim vectors of 2 vectors of index particles to send (1 per direction) 
     //!   - not sent
@@ -49,6 +86,19 @@ public:
     std::vector< std::vector< int > > part_index_send_sz;
     //! ndim vectors of 2 numbers of particles to receive (1 per direction) 
     std::vector< std::vector< int > > part_index_recv_sz;
+    
+    // Buffers of the single round exchange with all neighbors (single_round_particle_exchange)
+    // 3^ndim elements, indexed as Patch::corner_neighbor_ (by destination for send, by origin for recv)
+    //! sent and received requests per neighbor
+    std::vector< MPI_Request > srequest_corner, rrequest_corner;
+    //! received packets of particles per neighbor
+    std::vector< Particles > partRecv_corner;
+    //! packed buffers of particles to send and received per neighbor
+    std::vector< std::vector<char> > bufferSend_corner, bufferRecv_corner;
+    //! indexes of particles to send per neighbor
+    std::vector< std::vector<int> > part_index_send_corner;
+    //! numbers of particles to send and to receive per neighbor
+    std::vector< int > part_index_send_sz_corner, part_index_recv_sz_corner;
 
 };
 
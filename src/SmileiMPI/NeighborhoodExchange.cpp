@@ -0,0 +1,169 @@
+
+#include "NeighborhoodExchange.h"
+#include "Tools.h"
+
+#include <algorithm>
+using namespace std;
+
+NeighborhoodExchange::NeighborhoodExchange()
+{
+    comm_ = MPI_COMM_NULL;
+    bytes_sent_ = 0.;
+    n_exchanges_ = 0;
+}
+
+
+NeighborhoodExchange::~NeighborhoodExchange()
+{
+    int finalized;
+    MPI_Finalized( &finalized );
+    if ( finalized ) return;
+    
+    // Exchange started at the last iteration : the fields receiving it may not exist anymore, nothing unpacked
+    for (map< pair<const void*,int>, exchange >::iterator it=pending_.begin() ; it!=pending_.end() ; it++)
+        MPI_Wait( &(it->second.request), MPI_STATUS_IGNORE );
+    if ( comm_ != MPI_COMM_NULL )
+        MPI_Comm_free( &comm_ );
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Topology communicator whose neighbors are the processes owning a neighbor patch, to create again each time the
+// patches move between processes (creation, load balancing)
+// ---------------------------------------------------------------------------------------------------------------------
+void NeighborhoodExchange::create( MPI_Comm comm, vector<int>& ranks )
+{
+    if ( pending_.size() > 0 )
+        ERROR( "Topology communicator created again while " << pending_.size() << " ghost exchanges are pending" );
+
+    if ( comm_ != MPI_COMM_NULL )
+        MPI_Comm_free( &comm_ );
+
+    ranks_ = ranks;
+    sort( ranks_.begin(), ranks_.end() );
+    ranks_.erase( unique( ranks_.begin(), ranks_.end() ), ranks_.end() );
+    index_.clear();
+    for (unsigned int i=0 ; i<ranks_.size() ; i++)
+        index_[ranks_[i]] = i;
+
+    // Ranks kept (reorder = 0), so that the patches use the ranks of comm
+    int degree = ranks_.size();
+    MPI_Dist_graph_create_adjacent( comm, degree, ranks_.data(), MPI_UNWEIGHTED,
+                                          degree, ranks_.data(), MPI_UNWEIGHTED, MPI_INFO_NULL, 0, &comm_ );
+
+    sends_.clear();
+    recvs_.clear();
+    sends_.resize( degree );
+    recvs_.resize( degree );
+
+} // END create
+
+
+void NeighborhoodExchange::send( void* buf, int count, MPI_Datatype type, int dest, int tag )
+{
+    message m = { tag, buf, count, type };
+    #pragma omp critical (neighborhood_post)
+    {
+        map<int,int>::iterator it = index_.find( dest );
+        if ( it == index_.end() )
+            ERROR( "Process " << dest << " is not in the neighborhood" );
+        sends_[it->second].push_back( m );
+    }
+}
+
+
+void NeighborhoodExchange::recv( void* buf, int count, MPI_Datatype type, int source, int tag )
+{
+    message m = { tag, buf, count, type };
+    #pragma omp critical (neighborhood_post)
+    {
+        map<int,int>::iterator it = index_.find( source );
+        if ( it == index_.end() )
+            ERROR( "Process " << source << " is not in the neighborhood" );
+        recvs_[it->second].push_back( m );
+    }
+}
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Sizes of the packed messages per neighbor : the type signatures of a send and of the matching receive are the same,
+// so both processes compute the same sizes
+// ---------------------------------------------------------------------------------------------------------------------
+void NeighborhoodExchange::layout( vector< vector<message> >& msgs, vector<int>& counts, vector<int>& displs )
+{
+    counts.resize( msgs.size(), 0 );
+    displs.resize( msgs.size(), 0 );
+    int displ = 0;
+    for (unsigned int i=0 ; i<msgs.size() ; i++) {
+        sort( msgs[i].begin(), msgs[i].end() );
+        displs[i] = displ;
+        for (unsigned int j=0 ; j<msgs[i].size() ; j++) {
+            int size;
+            MPI_Type_size( msgs[i][j].type, &size );
+            counts[i] += size * msgs[i][j].count;
+        }
+        displ += counts[i];
+    }
+}
+
+
+void NeighborhoodExchange::start( const void* key, int iDim )
+{
+    pair<const void*,int> k( key, iDim );
+    if ( pending_.find( k ) != pending_.end() )
+        ERROR( "Ghost exchange started twice before its completion" );
+    exchange& ex = pending_[k];
+
+    layout( sends_, ex.scounts, ex.sdispls );
+    layout( recvs_, ex.rcounts, ex.rdispls );
+    ex.sbuf.resize( ranks_.size() > 0 ? ex.sdispls.back() + ex.scounts.back() : 0 );
+    ex.rbuf.resize( ranks_.size() > 0 ? ex.rdispls.back() + ex.rcounts.back() : 0 );
+
+    for (unsigned int i=0 ; i<sends_.size() ; i++) {
+        int position = ex.sdispls[i];
+        for (unsigned int j=0 ; j<sends_[i].size() ; j++)
+            MPI_Pack( sends_[i][j].buf, sends_[i][j].count, sends_[i][j].type, ex.sbuf.data(), ex.sbuf.size(), &position, comm_ );
+        sends_[i].clear();
+    }
+
+    MPI_Ineighbor_alltoallv( ex.sbuf.data(), ex.scounts.data(), ex.sdispls.data(), MPI_PACKED,
+                             ex.rbuf.data(), ex.rcounts.data(), ex.rdispls.data(), MPI_PACKED, comm_, &ex.request );
+
+    ex.recvs.swap( recvs_ );
+    recvs_.resize( ranks_.size() );
+
+    bytes_sent_ += ex.sbuf.size();
+    n_exchanges_++;
+
+} // END start
+
+
+void NeighborhoodExchange::complete( const void* key, int iDim )
+{
+    map< pair<const void*,int>, exchange >::iterator it = pending_.find( pair<const void*,int>( key, iDim ) );
+    if ( it == pending_.end() ) return;
+    exchange& ex = it->second;
+
+    MPI_Wait( &ex.request, MPI_STATUS_IGNORE );
+
+    for (unsigned int i=0 ; i<ex.recvs.size() ; i++) {
+        int position = ex.rdispls[i];
+        for (unsigned int j=0 ; j<ex.recvs[i].size() ; j++)
+            MPI_Unpack( ex.rbuf.data(), ex.rbuf.size(), &position, ex.recvs[i][j].buf, ex.recvs[i][j].count, ex.recvs[i][j].type, comm_ );
+    }
+
+    pending_.erase( it );
+
+} // END complete
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// The exchange of B started at the end of an iteration is completed during the next one : complete it before the
+// patches whose fields receive the ghost layers are sent or deleted (load balancing, moving window)
+// ---------------------------------------------------------------------------------------------------------------------
+void NeighborhoodExchange::completeAll()
+{
+    while ( pending_.size() > 0 )
+        complete( pending_.begin()->first.first, pending_.begin()->first.second );
+
+} // END completeAll
@@ -0,0 +1,79 @@
+#ifndef NEIGHBORHOODEXCHANGE_H
+#define NEIGHBORHOODEXCHANGE_H
+
+#include <mpi.h>
+#include <vector>
+#include <map>
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Class NeighborhoodExchange
+//!   Ghost cells of the fields exchanged with a neighborhood collective (MPI_Ineighbor_alltoallv) on a topology
+//!   communicator whose neighbors are the MPI processes owning a neighbor patch, instead of point-to-point messages :
+//!   - the patches post their messages (send, recv) as they would call MPI_Isend/Irecv (see AsyncMPIbuffers::isend)
+//!   - start packs the messages per process and starts the collective, complete waits for it and unpacks
+//!   The messages between 2 processes are ordered by tag, the same on both sides (see buildtag)
+//  --------------------------------------------------------------------------------------------------------------------
+class NeighborhoodExchange {
+public:
+    NeighborhoodExchange();
+    ~NeighborhoodExchange();
+
+    //! (Re)create the topology communicator from the ranks owning a neighbor patch (collective on comm)
+    //! The neighborhood is symmetric : the same ranks are sources and destinations
+    void create( MPI_Comm comm, std::vector<int>& ranks );
+
+    //! Post a message to rank dest (replaces MPI_Isend), thread safe
+    void send( void* buf, int count, MPI_Datatype type, int dest, int tag );
+    //! Post a message from rank source (replaces MPI_Irecv), thread safe
+    void recv( void* buf, int count, MPI_Datatype type, int source, int tag );
+
+    //! Start the collective for the messages posted since the last start, completed by complete( key )
+    //! Called by all processes in the same order, key identifies the exchange (several can be pending)
+    void start( const void* key, int iDim );
+    //! Wait for the collective started with key, and unpack the received messages (nothing if already completed)
+    void complete( const void* key, int iDim );
+    //! Complete all the pending collectives, before the patches move between processes
+    void completeAll();
+
+    //! Bytes sent through the neighborhood collectives since the creation of the object
+    inline double bytesSent() { return bytes_sent_; }
+    //! Number of collectives since the creation of the object
+    inline int nExchanges() { return n_exchanges_; }
+
+private:
+    //! Message posted by a patch
+    struct message {
+        int tag;
+        void* buf;
+        int count;
+        MPI_Datatype type;
+        bool operator<( const message& m ) const { return tag < m.tag; }
+    };
+    //! Collective in progress, with its buffers and the messages to unpack
+    struct exchange {
+        std::vector<char> sbuf, rbuf;
+        std::vector<int> scounts, sdispls, rcounts, rdispls;
+        std::vector< std::vector<message> > recvs;
+        MPI_Request request;
+    };
+
+    //! Pack the messages of each neighbor in buf, ordered by tag
+    void layout( std::vector< std::vector<message> >& msgs, std::vector<int>& counts, std::vector<int>& displs );
+
+    //! Topology communicator (MPI_Dist_graph_create_adjacent)
+    MPI_Comm comm_;
+    //! Ranks of the neighbors in the communicator used to create comm_, and the reverse
+    std::vector<int> ranks_;
+    std::map<int,int> index_;
+
+    //! Messages posted since the last start, per neighbor
+    std::vector< std::vector<message> > sends_, recvs_;
+    //! Collectives started and not completed yet
+    std::map< std::pair<const void*,int>, exchange > pending_;
+
+    double bytes_sent_;
+    int n_exchanges_;
+
+};
+
+#endif
@@ -12,6 +12,7 @@
 #include "Tools.h"
 
 #include "ElectroMagn.h"
+#include "FieldArena.h"
 #include "ElectroMagnBC1D_SM.h"
 #include "ElectroMagnBC2D_SM.h"
 #include "ElectroMagnBC3D_SM.h"
@@ -51,6 +52,37 @@ SmileiMPI::SmileiMPI( int* argc, char*** argv )
     SMILEI_COMM_WORLD = MPI_COMM_WORLD;
     MPI_Comm_size( SMILEI_COMM_WORLD, &smilei_sz );
     MPI_Comm_rank( SMILEI_COMM_WORLD, &smilei_rk );
+    MPI_Comm_dup( SMILEI_COMM_WORLD, &SMILEI_COMM_PARTICLES );
+    
+    // Processes sharing the same node, ordered as in SMILEI_COMM_WORLD
+    MPI_Comm_split_type( SMILEI_COMM_WORLD, MPI_COMM_TYPE_SHARED, smilei_rk, MPI_INFO_NULL, &SMILEI_COMM_NODE );
+    MPI_Comm_size( SMILEI_COMM_NODE, &node_sz );
+    MPI_Comm_rank( SMILEI_COMM_NODE, &node_rk );
+    // The patches of a node form a contiguous segment of the Hilbert curve only if the ranks of each node are contiguous
+    int node_first_rk, node_sz_max, contiguous;
+    MPI_Allreduce( &smilei_rk, &node_first_rk, 1, MPI_INT, MPI_MIN, SMILEI_COMM_NODE );
+    contiguous = ( smilei_rk == node_first_rk + node_rk );
+    MPI_Allreduce( &contiguous, &node_balancing_, 1, MPI_INT, MPI_LAND, SMILEI_COMM_WORLD );
+    MPI_Allreduce( &node_sz, &node_sz_max, 1, MPI_INT, MPI_MAX, SMILEI_COMM_WORLD );
+    node_balancing_ = node_balancing_ && ( node_sz_max > 1 );
+    // Rank in the node of all processes, to identify the neighbors reachable through the shared memory
+    MPI_Group world_group, node_group;
+    MPI_Comm_group( SMILEI_COMM_WORLD, &world_group );
+    MPI_Comm_group( SMILEI_COMM_NODE, &node_group );
+    vector<int> world_ranks( smilei_sz );
+    for (int irk=0 ; irk<smilei_sz ; irk++) world_ranks[irk] = irk;
+    world_to_node_.resize( smilei_sz );
+    MPI_Group_translate_ranks( world_group, smilei_sz, &world_ranks[0], node_group, &world_to_node_[0] );
+    for (int irk=0 ; irk<smilei_sz ; irk++)
+        if ( world_to_node_[irk] == MPI_UNDEFINED ) world_to_node_[irk] = -1;
+    MPI_Group_free( &world_group );
+    MPI_Group_free( &node_group );
+    
+    shared_ghosts_ = false;
+    ghost_win_ = MPI_WIN_NULL;
+    ghost_slot_bytes_ = 0;
+    ghost_ndim_ = 0;
+    neighborhood_ = NULL;
 
     MESSAGE("                   _            _");
     MESSAGE(" ___           _  | |        _  \\ \\   Version : " << __VERSION);
@@ -71,6 +103,14 @@ SmileiMPI::~SmileiMPI()
 {
     delete[]periods_;
 
+    if ( ghost_win_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( ghost_win_ );
+        MPI_Win_free( &ghost_win_ );
+    }
+    if ( neighborhood_ )
+        delete neighborhood_;
+    MPI_Comm_free( &SMILEI_COMM_PARTICLES );
+    MPI_Comm_free( &SMILEI_COMM_NODE );
     MPI_Finalize();
 
 } // END SmileiMPI::~SmileiMPI
@@ -127,14 +167,23 @@ void SmileiMPI::init( Params& params )
     dynamics_invgf.resize(omp_get_max_threads());
     dynamics_iold.resize(omp_get_max_threads());
     dynamics_deltaold.resize(omp_get_max_threads());
+    dynamics_Jtile.resize(omp_get_max_threads());
 #else
     dynamics_Epart.resize(1);
     dynamics_Bpart.resize(1);
     dynamics_invgf.resize(1);
     dynamics_iold.resize(1);
     dynamics_deltaold.resize(1);
+    dynamics_Jtile.resize(1);
 #endif
 
+    // Ghost layers through the shared memory only useful if several processes run on the node
+    shared_ghosts_ = params.shared_memory_ghosts && ( node_sz > 1 );
+    ghost_ndim_ = params.nDim_field;
+    
+    if ( params.neighborhood_collectives )
+        neighborhood_ = new NeighborhoodExchange();
+
     // Set periodicity of the simulated problem
     periods_  = new int[params.nDim_field];
     for (unsigned int i=0 ; i<params.nDim_field ; i++) periods_[i] = 0;
@@ -369,8 +418,12 @@ void SmileiMPI::init_patch_count( Params& params)
 // ---------------------------------------------------------------------------------------------------------------------
 //  Recompute patch distribution
 // ---------------------------------------------------------------------------------------------------------------------
-void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches, double time_dual )
+void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches, double time_dual, bool node_only )
 {
+    // Patches shifted between all the processes, or only inside each node (the bounds of the nodes do not move)
+    MPI_Comm comm = node_only ? SMILEI_COMM_NODE : SMILEI_COMM_WORLD;
+    int rk = node_only ? node_rk : smilei_rk;
+    int sz = node_only ? node_sz : smilei_sz;
 
     //cout << "Start recompute" << endl;
     unsigned int Npatches,ncells_perpatch, j;
@@ -381,7 +434,7 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     std::vector<double> Lp, Lp_left, Lp_right;
     ofstream fout;
 
-    if (isMaster()) {
+    if (isMaster() && !node_only) {
         fout.open ("patch_load.txt", std::ofstream::out | std::ofstream::app);
     }
     
@@ -396,50 +449,73 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     cells_load = ncells_perpatch*params.coef_cell ;
 
     Lp.resize(patch_count[smilei_rk], cells_load);
-    if (smilei_rk > 0) Lp_left.resize(patch_count[smilei_rk-1]);
-    if (smilei_rk < smilei_sz-1) Lp_right.resize(patch_count[smilei_rk+1]);
+    if (rk > 0) Lp_left.resize(patch_count[smilei_rk-1]);
+    if (rk < sz-1) Lp_right.resize(patch_count[smilei_rk+1]);
 
     Tload_loc = 0.;
     Ncur = 0; // Number of patches assigned to current rank r.
 
     //Compute Local Loads of each Patch (Lp)
+    std::vector<double> Lpart(patch_count[smilei_rk], 0.);
     for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++){
         for (unsigned int ispecies = 0; ispecies < tot_species_number; ispecies++) {
-            Lp[ipatch] += vecpatches(ipatch)->vecSpecies[ispecies]->getNbrOfParticles()*(1+(params.coef_frozen-1)*(time_dual < vecpatches(ipatch)->vecSpecies[ispecies]->time_frozen)) ;
+            Lpart[ipatch] += vecpatches(ipatch)->vecSpecies[ispecies]->getNbrOfParticles()*(1+(params.coef_frozen-1)*(time_dual < vecpatches(ipatch)->vecSpecies[ispecies]->time_frozen)) ;
         }
+    }
+    
+    //Blend the estimated load of the particles with their measured load (coef_measured),
+    //the measured times being scaled to the same total as the estimate
+    if (params.coef_measured > 0.) {
+        double local_sums[2] = {0., 0.}, sums[2];
+        for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++){
+            local_sums[0] += Lpart[ipatch];
+            local_sums[1] += vecpatches(ipatch)->measured_load;
+        }
+        MPI_Allreduce(local_sums, sums, 2, MPI_DOUBLE, MPI_SUM, comm);
+        //No measure yet (initial balance)
+        if (sums[1] > 0.) {
+            double scale = sums[0] / sums[1];
+            for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++)
+                Lpart[ipatch] = (1.-params.coef_measured) * Lpart[ipatch]
+                              + params.coef_measured * scale * vecpatches(ipatch)->measured_load;
+        }
+    }
+    
+    for(unsigned int ipatch=0; ipatch < (unsigned int)patch_count[smilei_rk]; ipatch++){
+        Lp[ipatch] += Lpart[ipatch];
         Tload_loc += Lp[ipatch];
     }
 
     //Tscan = total load carried by previous ranks and me 
-    MPI_Scan(&Tload_loc, &Tscan, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Scan(&Tload_loc, &Tscan, 1, MPI_DOUBLE, MPI_SUM, comm);
     //Tload = total load carried by all ranks 
-    MPI_Allreduce(&Tload_loc, &Tload, 1, MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD);
+    MPI_Allreduce(&Tload_loc, &Tload, 1, MPI_DOUBLE, MPI_SUM, comm);
 
     //Communicate the detail of the load of each patch to neighbouring MPI ranks
-    if (smilei_rk < smilei_sz-1) {
-        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk+1, 0, MPI_COMM_WORLD, &request0 );
+    if (rk < sz-1) {
+        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, rk+1, 0, comm, &request0 );
     }
-    if (smilei_rk > 0) {
-        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, smilei_rk-1, 1, MPI_COMM_WORLD, &request1 );
-        MPI_Recv( &(Lp_left[0]), patch_count[smilei_rk-1], MPI_DOUBLE, smilei_rk-1, 0, MPI_COMM_WORLD, &status0 );
+    if (rk > 0) {
+        MPI_Isend( &(Lp[0]), patch_count[smilei_rk], MPI_DOUBLE, rk-1, 1, comm, &request1 );
+        MPI_Recv( &(Lp_left[0]), patch_count[smilei_rk-1], MPI_DOUBLE, rk-1, 0, comm, &status0 );
     }
-    if (smilei_rk < smilei_sz-1){
-        MPI_Recv( &(Lp_right[0]), patch_count[smilei_rk+1], MPI_DOUBLE, smilei_rk+1, 1, MPI_COMM_WORLD, &status1);
+    if (rk < sz-1){
+        MPI_Recv( &(Lp_right[0]), patch_count[smilei_rk+1], MPI_DOUBLE, rk+1, 1, comm, &status1);
     }
 
-    Tload /= Tcapabilities; //Target load for each mpi process.
+    Tload /= node_only ? node_sz : Tcapabilities; //Target load for each mpi process.
     //Tcur = Tload * capabilities[smilei_rk];  //Init.
 
-    if (smilei_rk > 0)
+    if (rk > 0)
         MPI_Wait(&request1, &status);
-    if (smilei_rk < smilei_sz-1)
+    if (rk < sz-1)
         MPI_Wait(&request0, &status);
 
-    if (smilei_rk > 0){
+    if (rk > 0){
         //Tcur is now initialized as the total load currently carried by previous ranks.
         Tcur = Tscan - Tload_loc;
         //Check if my rank should start with additional patches from left neighbour.
-        target = smilei_rk*Tload; //target here points at the optimal begining for current rank
+        target = rk*Tload; //target here points at the optimal begining for current rank
         if (Tcur > target){
             j = Lp_left.size()-1;
             while (abs(Tcur-target) > abs(Tcur-Lp_left[j] - target) && j>0){ //Leave at least 1 patch to my neighbour.
@@ -458,10 +534,10 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
         }
     }
 
-    if (smilei_rk < smilei_sz-1){
+    if (rk < sz-1){
         //Tcur is now initialized as the total load carried by previous ranks + my load.
         Tcur = Tscan;
-        target = (smilei_rk+1)*Tload;
+        target = (rk+1)*Tload;
 
         //Check if my rank should start with additional patches from right neighbour ...
         if (Tcur < target){
@@ -486,11 +562,11 @@ void SmileiMPI::recompute_patch_count( Params& params, VectorPatch& vecpatches,
     //Stores in Ncur the final patch count of this rank
     Ncur += patch_count[smilei_rk] ;
 
-    //Ncur now has to be gathered to all as target_patch_count[smilei_rk]
+    //Ncur now has to be gathered to all as target_patch_count[smilei_rk], all the processes of all nodes
     MPI_Allgather(&Ncur,1,MPI_INT,&patch_count[0], 1, MPI_INT,MPI_COMM_WORLD);
 
     //Write patch_load.txt
-    if (smilei_rk==0) {
+    if (smilei_rk==0 && !node_only) {
         fout << "\tt = " << time_dual << endl;
         for (int irk=0;irk<smilei_sz;irk++)
             fout << " patch_count[" << irk << "] = " << patch_count[irk] << endl;
@@ -520,48 +596,116 @@ int SmileiMPI::hrank(int h)
 } // END hrank
 
 
-// ----------------------------------------------------------------------
-// Create MPI type to exchange all particles properties of particles
-// ----------------------------------------------------------------------
-MPI_Datatype SmileiMPI::createMPIparticles( Particles* particles )
+// ---------------------------------------------------------------------------------------------------------------------
+// (Re)allocate the shared memory window used as a mailbox for the field ghost layers between the processes of a node
+//   - each process owns a segment : SMILEI_GHOST_MSGS slots per patch, per direction and per neighbor
+//   - collective on SMILEI_COMM_NODE, to call each time the patch distribution changes
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::allocateGhostWindow( Params& params )
 {
-    int nbrOfProp = particles->double_prop.size() + particles->short_prop.size() + particles->uint64_prop.size();
+    if ( !shared_ghosts_ ) return;
+    
+    if ( ghost_win_ != MPI_WIN_NULL ) {
+        MPI_Win_unlock_all( ghost_win_ );
+        MPI_Win_free( &ghost_win_ );
+    }
+    
+    // Largest ghost layer : oversize cells in iDim, all the (dual) cells of the other directions
+    int layer_max(0);
+    for (unsigned int iDim=0 ; iDim<params.nDim_field ; iDim++) {
+        int layer = params.oversize[iDim];
+        for (unsigned int jDim=0 ; jDim<params.nDim_field ; jDim++)
+            if ( jDim != iDim ) layer *= params.n_space[jDim] + 2 + 2*params.oversize[jDim];
+        layer_max = max( layer_max, layer );
+    }
+    MPI_Pack_size( layer_max, MPI_DOUBLE, SMILEI_COMM_WORLD, &ghost_slot_bytes_ );
+    ghost_slot_bytes_ = ( (ghost_slot_bytes_ + sizeof(double) - 1) / sizeof(double) ) * sizeof(double);
+    
+    MPI_Aint size = (MPI_Aint)patch_count[smilei_rk] * ghost_ndim_ * 2 * SMILEI_GHOST_MSGS * ghost_slot_bytes_;
+    
+    // Segments not necessarily contiguous, to be allocated in the memory of the NUMA domain of each process
+    MPI_Info info;
+    MPI_Info_create( &info );
+    MPI_Info_set( info, "alloc_shared_noncontig", "true" );
+    char* base;
+    MPI_Win_allocate_shared( size, 1, info, SMILEI_COMM_NODE, &base, &ghost_win_ );
+    MPI_Info_free( &info );
+    
+    ghost_base_.resize( node_sz );
+    for (int irk=0 ; irk<node_sz ; irk++) {
+        MPI_Aint segment_size;
+        int disp_unit;
+        MPI_Win_shared_query( ghost_win_, irk, &segment_size, &disp_unit, &ghost_base_[irk] );
+    }
+    
+    // Passive epoch for the whole life of the window, synchronized by syncGhostWindow
+    MPI_Win_lock_all( MPI_MODE_NOCHECK, ghost_win_ );
+    
+} // END allocateGhostWindow
 
-    MPI_Aint address[nbrOfProp];
-    for ( unsigned int iprop=0 ; iprop<particles->double_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->double_prop[iprop]))[0] ), &(address[iprop]) );
-    for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->short_prop[iprop]))[0] ), &(address[particles->double_prop.size()+iprop]) );
-    for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        MPI_Get_address( &( (*(particles->uint64_prop[iprop]))[0] ), &(address[particles->double_prop.size()+particles->short_prop.size()+iprop]) );
 
-    int nbr_parts[nbrOfProp];
-    // number of elements per property
-    for (int i=0 ; i<nbrOfProp ; i++)
-        nbr_parts[i] = particles->size();
+// ---------------------------------------------------------------------------------------------------------------------
+// Address of the slots of the ghost layers sent by patch h, owned by process rank, to its neighbor iNeighbor in iDim
+// ---------------------------------------------------------------------------------------------------------------------
+char* SmileiMPI::ghostSlot( int rank, int h, int iDim, int iNeighbor )
+{
+    int hfirst(0);
+    for (int irk=0 ; irk<rank ; irk++) hfirst += patch_count[irk];
+    
+    return ghost_base_[ world_to_node_[rank] ]
+        + ( ( (MPI_Aint)(h-hfirst)*ghost_ndim_ + iDim )*2 + iNeighbor ) * SMILEI_GHOST_MSGS * ghost_slot_bytes_;
+    
+} // END ghostSlot
+
 
-    MPI_Aint disp[nbrOfProp];
-    // displacement between 2 properties
-    disp[0] = 0;
-    for (int i=1 ; i<nbrOfProp ; i++)
-        disp[i] = address[i] - address[0];
+// ---------------------------------------------------------------------------------------------------------------------
+// Memory barrier on the shared memory window : all the ghost layers packed by the processes of the node before are
+// visible to all after (and no process overwrites the slots before the others leave the same barrier)
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::syncGhostWindow()
+{
+    MPI_Win_sync( ghost_win_ );
+    MPI_Barrier( SMILEI_COMM_NODE );
+    MPI_Win_sync( ghost_win_ );
+    
+} // END syncGhostWindow
 
-    MPI_Datatype partDataType[nbrOfProp];
-    // define MPI type of each property, default is DOUBLE
-    for ( unsigned int i=0 ; i<particles->double_prop.size() ; i++)
-        partDataType[i] = MPI_DOUBLE;
-    for ( unsigned int iprop=0 ; iprop<particles->short_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+iprop] = MPI_SHORT;
-    for ( unsigned int iprop=0 ; iprop<particles->uint64_prop.size() ; iprop++ )
-        partDataType[ particles->double_prop.size()+particles->short_prop.size()+iprop] = MPI_UNSIGNED_LONG_LONG;
 
-    MPI_Datatype typeParticlesMPI;
-    MPI_Type_create_struct( nbrOfProp, &(nbr_parts[0]), &(disp[0]), &(partDataType[0]), &typeParticlesMPI);
-    MPI_Type_commit( &typeParticlesMPI );
+// ---------------------------------------------------------------------------------------------------------------------
+// Topology communicator of the neighborhood collectives : the processes owning a face neighbor of a local patch
+//   - the patch neighborhood being symmetric, so is the process neighborhood
+//   - to call each time the patches move between processes, once their MPI neighbors updated (see updateMPIenv)
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::createNeighborhood( VectorPatch& vecPatches )
+{
+    if ( !neighborhood_ ) return;
     
-    return typeParticlesMPI;
+    vector<int> ranks;
+    for (unsigned int ipatch=0 ; ipatch<vecPatches.size() ; ipatch++)
+        for (unsigned int iDim=0 ; iDim<vecPatches(ipatch)->MPI_neighbor_.size() ; iDim++)
+            for (int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++)
+                if ( vecPatches(ipatch)->is_a_MPI_neighbor( iDim, iNeighbor ) )
+                    ranks.push_back( vecPatches(ipatch)->MPI_neighbor_[iDim][iNeighbor] );
+    
+    neighborhood_->create( SMILEI_COMM_WORLD, ranks );
+    
+} // END createNeighborhood
+
 
-} // END createMPIparticles
+void SmileiMPI::neighborhoodVolume()
+{
+    if ( !neighborhood_ ) return;
+    
+    double bytes = neighborhood_->bytesSent();
+    double bytes_sum, bytes_max;
+    MPI_Reduce( &bytes, &bytes_sum, 1, MPI_DOUBLE, MPI_SUM, 0, SMILEI_COMM_WORLD );
+    MPI_Reduce( &bytes, &bytes_max, 1, MPI_DOUBLE, MPI_MAX, 0, SMILEI_COMM_WORLD );
+    
+    int n = max( neighborhood_->nExchanges(), 1 );
+    MESSAGE( "Ghost cells through neighborhood collectives : " << neighborhood_->nExchanges() << " exchanges" );
+    MESSAGE( 1, "Sent per exchange (all processes) : " << bytes_sum/n/1.e6 << " MB, process max : " << bytes_max/n/1.e6 << " MB" );
+    
+} // END neighborhoodVolume
 
 
 // ---------------------------------------------------------------------------------------------------------------------
@@ -573,13 +717,14 @@ void SmileiMPI::isend(Patch* patch, int to, int tag, Params& params)
 {
     //MPI_Request request;
 
+    // The particles of all species are packed in a single buffer, sent in one message
+    patch->exchangeBuffer.clear();
     for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++){
         isend( &(patch->vecSpecies[ispec]->bmax), to, tag+2*ispec+1, patch->requests_[2*ispec] );
-        if ( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ){
-            patch->vecSpecies[ispec]->exchangePatch = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            isend( patch->vecSpecies[ispec]->particles, to, tag+2*ispec, patch->vecSpecies[ispec]->exchangePatch, patch->requests_[2*ispec+1] );
-        }
+        patch->vecSpecies[ispec]->particles->pack( patch->exchangeBuffer, 0, patch->vecSpecies[ispec]->getNbrOfParticles() );
     }
+    if ( patch->exchangeBuffer.size() > 0 )
+        isend( &(patch->exchangeBuffer), to, tag, patch->requests_[1] );
 
     // Count number max of comms :
     int maxtag = 2 * patch->vecSpecies.size();
@@ -598,64 +743,87 @@ void SmileiMPI::waitall(Patch* patch)
         //AB: This operation is done in MPI_Wait already.
         //patch->requests_[ireq] = MPI_REQUEST_NULL;
     }
+    
+}
+
+void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
+{
+    irecv( patch, from, tag, params );
+    waitRecv( patch, from, tag, params );
+
+} // END recv ( Patch )
+
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Post the receptions of a patch whose size is known (bin bounds of the species and fields), without waiting
+// The particles, whose number is only known once bmax is received, are received by waitRecv
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::irecv(Patch* patch, int from, int tag, Params& params)
+{
     for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++)
-        if ( patch->vecSpecies[ispec]->getNbrOfParticles() > 0 ) {
-            if (patch->vecSpecies[ispec]->exchangePatch != MPI_DATATYPE_NULL) {
-                MPI_Type_free( &(patch->vecSpecies[ispec]->exchangePatch) );
-                patch->vecSpecies[ispec]->exchangePatch = MPI_DATATYPE_NULL;
-            }
-        }
+        irecv( &patch->vecSpecies[ispec]->bmax, from, tag+2*ispec+1, patch->requests_[2*ispec] );
+    
+    // Count number max of comms :
+    int maxtag = 2 * patch->vecSpecies.size();
+    
+    patch->EMfields->initAntennas(patch);
+    irecv( patch->EMfields, from, maxtag, patch->requests_, tag );
 
-        
-}
+} // END irecv ( Patch )
 
-void SmileiMPI::recv(Patch* patch, int from, int tag, Params& params)
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Complete the reception of a patch posted by irecv
+// ---------------------------------------------------------------------------------------------------------------------
+void SmileiMPI::waitRecv(Patch* patch, int from, int tag, Params& params)
 {
-    MPI_Datatype recvParts;
     int nbrOfPartsRecv;
-
+    size_t nbrOfBytesRecv(0);
+    MPI_Status status;
+    
     for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++){
-        //Receive bmax
-        recv( &patch->vecSpecies[ispec]->bmax, from, tag+2*ispec+1 );
+        //Wait for bmax
+        MPI_Wait( &(patch->requests_[2*ispec]), &status );
         //Reconstruct bmin from bmax
         memcpy(&(patch->vecSpecies[ispec]->bmin[1]), &(patch->vecSpecies[ispec]->bmax[0]), (patch->vecSpecies[ispec]->bmax.size()-1)*sizeof(int) );
         patch->vecSpecies[ispec]->bmin[0]=0;
         //Prepare patch for receiving particles
         nbrOfPartsRecv = patch->vecSpecies[ispec]->bmax.back(); 
-        //cout << smilei_rk << " recv " << nbrOfPartsRecv << endl;
         patch->vecSpecies[ispec]->particles->initialize( nbrOfPartsRecv, params.nDim_particle );
-        //Receive particles
-        if ( nbrOfPartsRecv > 0 ) {
-            recvParts = createMPIparticles( patch->vecSpecies[ispec]->particles );
-            recv( patch->vecSpecies[ispec]->particles, from, tag+2*ispec, recvParts );
-            MPI_Type_free( &(recvParts) );
-        }
+        nbrOfBytesRecv += nbrOfPartsRecv * patch->vecSpecies[ispec]->particles->packedSize();
     }
     
-    // Count number max of comms :
-    int maxtag = tag + 2 * patch->vecSpecies.size();
-
-    patch->EMfields->initAntennas(patch);
-    recv( patch->EMfields, from, maxtag );
-
+    //Receive the particles of all species in a single packed buffer
+    if ( nbrOfBytesRecv > 0 ) {
+        patch->exchangeBuffer.resize( nbrOfBytesRecv );
+        recv( &(patch->exchangeBuffer), from, tag );
+        const char* buffer = &(patch->exchangeBuffer[0]);
+        for (int ispec=0 ; ispec<(int)patch->vecSpecies.size() ; ispec++)
+            buffer += patch->vecSpecies[ispec]->particles->unpack( buffer, patch->vecSpecies[ispec]->bmax.back() );
+        vector<char>().swap( patch->exchangeBuffer );
+    }
+    
+    //Fields
+    waitall( patch );
 
-} // END recv ( Patch )
+} // END waitRecv ( Patch )
 
 
-void SmileiMPI::isend(Particles* particles, int to, int tag, MPI_Datatype typePartSend, MPI_Request& request)
+// Packed buffer of particles (see Particles::pack). Asynchronous.
+void SmileiMPI::isend(std::vector<char>* vec, int to, int tag, MPI_Request& request)
 {
-    MPI_Isend( &(particles->position(0,0)), 1, typePartSend, to, tag, MPI_COMM_WORLD, &request );
+    MPI_Isend( &((*vec)[0]), (*vec).size(), MPI_BYTE, to, tag, MPI_COMM_WORLD, &request );
 
-} // END isend( Particles )
+} // END isend( packed particles )
 
 
-void SmileiMPI::recv(Particles* particles, int to, int tag, MPI_Datatype typePartRecv)
+// Assuming vec.size() is known (sum of the packed sizes of the particles)
+void SmileiMPI::recv(std::vector<char>* vec, int from, int tag)
 {
     MPI_Status status;
-    MPI_Recv( &(particles->position(0,0)), 1, typePartRecv, to, tag, MPI_COMM_WORLD, &status );
+    MPI_Recv( &((*vec)[0]), vec->size(), MPI_BYTE, from, tag, MPI_COMM_WORLD, &status );
 
-} // END recv( Particles )
+} // END recv( packed particles )
 
 
 // Assuming vec.size() is known (number of species). Asynchronous.
@@ -672,6 +840,13 @@ void SmileiMPI::recv(std::vector<int> *vec, int from, int tag)
 
 } // End recv
 
+// Assuming vec.size() is known. Asynchronous.
+void SmileiMPI::irecv(std::vector<int> *vec, int from, int tag, MPI_Request& request)
+{
+    MPI_Irecv( &((*vec)[0]), vec->size(), MPI_INT, from, tag, MPI_COMM_WORLD, &request );
+
+} // End irecv
+
 // Assuming vec.size() is known (number of species). Asynchronous.
 void SmileiMPI::isend(std::vector<double>* vec, int to, int tag, MPI_Request& request)
 {
@@ -686,18 +861,32 @@ void SmileiMPI::recv(std::vector<double> *vec, int from, int tag)
 
 } // End recv
 
+// Assuming vec.size() is known. Asynchronous.
+void SmileiMPI::irecv(std::vector<double> *vec, int from, int tag, MPI_Request& request)
+{
+    MPI_Irecv( &((*vec)[0]), vec->size(), MPI_DOUBLE, from, tag, MPI_COMM_WORLD, &request );
+
+} // End irecv
+
 
 void SmileiMPI::isend(ElectroMagn* EM, int to, int tag, vector<MPI_Request>& requests, int mpi_tag )
 {
-    isend( EM->Ex_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Ey_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Ez_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Bx_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->By_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Bz_ , to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Bx_m, to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->By_m, to, mpi_tag+tag, requests[tag]); tag++;
-    isend( EM->Bz_m, to, mpi_tag+tag, requests[tag]); tag++;
+    if ( EM->arena_ ) {
+        // Ex_ ... Bz_m contiguous in the arena : one message, the tags of the 9 fields kept
+        MPI_Isend( EM->arena_->data(), EM->arena_->offset(9), MPI_DOUBLE, to, mpi_tag+tag, MPI_COMM_WORLD, &requests[tag] );
+        tag += 9;
+    }
+    else {
+        isend( EM->Ex_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Ey_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Ez_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Bx_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->By_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Bz_ , to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Bx_m, to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->By_m, to, mpi_tag+tag, requests[tag]); tag++;
+        isend( EM->Bz_m, to, mpi_tag+tag, requests[tag]); tag++;
+    }
     
     for( unsigned int idiag=0; idiag<EM->allFields_avg.size(); idiag++) {
         for( unsigned int ifield=0; ifield<EM->allFields_avg[idiag].size(); ifield++) {
@@ -757,26 +946,34 @@ void SmileiMPI::isend(ElectroMagn* EM, int to, int tag, vector<MPI_Request>& req
 } // End isend ( ElectroMagn )
 
 
-void SmileiMPI::recv(ElectroMagn* EM, int from, int tag)
+// Same tags and requests as isend( ElectroMagn )
+void SmileiMPI::irecv(ElectroMagn* EM, int from, int tag, vector<MPI_Request>& requests, int mpi_tag )
 {
-    recv( EM->Ex_ , from, tag ); tag++;
-    recv( EM->Ey_ , from, tag ); tag++;
-    recv( EM->Ez_ , from, tag ); tag++;
-    recv( EM->Bx_ , from, tag ); tag++;
-    recv( EM->By_ , from, tag ); tag++;
-    recv( EM->Bz_ , from, tag ); tag++;
-    recv( EM->Bx_m, from, tag ); tag++;
-    recv( EM->By_m, from, tag ); tag++;
-    recv( EM->Bz_m, from, tag ); tag++;
+    if ( EM->arena_ ) {
+        // Ex_ ... Bz_m contiguous in the arena : one message, the tags of the 9 fields kept
+        MPI_Irecv( EM->arena_->data(), EM->arena_->offset(9), MPI_DOUBLE, from, mpi_tag+tag, MPI_COMM_WORLD, &requests[tag] );
+        tag += 9;
+    }
+    else {
+        irecv( EM->Ex_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Ey_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Ez_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Bx_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->By_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Bz_ , from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Bx_m, from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->By_m, from, mpi_tag+tag, requests[tag]); tag++;
+        irecv( EM->Bz_m, from, mpi_tag+tag, requests[tag]); tag++;
+    }
 
     for( unsigned int idiag=0; idiag<EM->allFields_avg.size(); idiag++) {
         for( unsigned int ifield=0; ifield<EM->allFields_avg[idiag].size(); ifield++) {
-            recv( EM->allFields_avg[idiag][ifield], from, tag); tag++;
+            irecv( EM->allFields_avg[idiag][ifield], from, mpi_tag+tag, requests[tag]); tag++;
         }
     }
      
-    for (int antennaId=0 ; antennaId<(int)EM->antennas.size() ; antennaId++) {
-        recv( EM->antennas[antennaId].field, from, tag); tag++;
+    for (unsigned int antennaId=0 ; antennaId<EM->antennas.size() ; antennaId++) {
+        irecv( EM->antennas[antennaId].field, from, mpi_tag+tag, requests[tag] ); tag++;
     }
      
     for (unsigned int bcId=0 ; bcId<EM->emBoundCond.size() ; bcId++ ) {
@@ -788,11 +985,11 @@ void SmileiMPI::recv(ElectroMagn* EM, int from, int tag)
                 LaserProfileSeparable* profile;
                 profile = static_cast<LaserProfileSeparable*> ( laser->profiles[0] );
                 if( ! profile->space_envelope ) continue;
-                recv( profile->space_envelope, from , tag ); tag++;
-                recv( profile->phase, from, tag ); tag++;
+                irecv( profile->space_envelope, from , mpi_tag+tag, requests[tag] ); tag++;
+                irecv( profile->phase, from, mpi_tag+tag, requests[tag]); tag++;
                 profile = static_cast<LaserProfileSeparable*> ( laser->profiles[1] );
-                recv( profile->space_envelope, from , tag ); tag++;
-                recv( profile->phase, from, tag ); tag++;
+                irecv( profile->space_envelope, from , mpi_tag+tag, requests[tag] ); tag++;
+                irecv( profile->phase, from, mpi_tag+tag, requests[tag]); tag++;
             }
         }
 
@@ -800,31 +997,30 @@ void SmileiMPI::recv(ElectroMagn* EM, int from, int tag)
  
             if (dynamic_cast<ElectroMagnBC1D_SM*>(EM->emBoundCond[bcId]) ) {
                 ElectroMagnBC1D_SM* embc = static_cast<ElectroMagnBC1D_SM*>(EM->emBoundCond[bcId]);
-                MPI_Status status;
-                MPI_Recv( &(embc->By_val), 1, MPI_DOUBLE, from, tag, MPI_COMM_WORLD, &status ); tag++;
-                MPI_Recv( &(embc->Bz_val), 1, MPI_DOUBLE, from, tag, MPI_COMM_WORLD, &status ); tag++;
+                MPI_Irecv( &(embc->By_val), 1, MPI_DOUBLE, from, mpi_tag+tag, MPI_COMM_WORLD, &requests[tag] ); tag++;
+                MPI_Irecv( &(embc->Bz_val), 1, MPI_DOUBLE, from, mpi_tag+tag, MPI_COMM_WORLD, &requests[tag] ); tag++;
             }
             else if ( dynamic_cast<ElectroMagnBC2D_SM*>(EM->emBoundCond[bcId]) ) {
                 // BCs at the x-border
                 ElectroMagnBC2D_SM* embc = static_cast<ElectroMagnBC2D_SM*>(EM->emBoundCond[bcId]);
-                if (embc->Bx_val.size()) recv(&embc->Bx_val, from, tag); tag++;
-                if (embc->By_val.size()) recv(&embc->By_val, from, tag); tag++;
-                if (embc->Bz_val.size()) recv(&embc->Bz_val, from, tag); tag++;
+                if (embc->Bx_val.size()) irecv(&embc->Bx_val, from, mpi_tag+tag, requests[tag]); tag++;
+                if (embc->By_val.size()) irecv(&embc->By_val, from, mpi_tag+tag, requests[tag]); tag++;
+                if (embc->Bz_val.size()) irecv(&embc->Bz_val, from, mpi_tag+tag, requests[tag]); tag++;
             }
              else if ( dynamic_cast<ElectroMagnBC3D_SM*>(EM->emBoundCond[bcId]) ) {
                 ElectroMagnBC3D_SM* embc = static_cast<ElectroMagnBC3D_SM*>(EM->emBoundCond[bcId]);
 
                  // BCs at the border
-                 if (embc->Bx_val) { recv( embc->Bx_val, from, tag); tag++;}
-                 if (embc->By_val) { recv( embc->By_val, from, tag); tag++;}
-                 if (embc->Bz_val) { recv( embc->Bz_val, from, tag); tag++;}
+                 if (embc->Bx_val) { irecv( embc->Bx_val, from, mpi_tag+tag, requests[tag]); tag++;}
+                 if (embc->By_val) { irecv( embc->By_val, from, mpi_tag+tag, requests[tag]); tag++;}
+                 if (embc->Bz_val) { irecv( embc->Bz_val, from, mpi_tag+tag, requests[tag]); tag++;}
 
              }
         }
 
     }
 
-} // End recv ( ElectroMagn )
+} // End irecv ( ElectroMagn )
 
 
 void SmileiMPI::isend(Field* field, int to, int hindex, MPI_Request& request)
@@ -842,6 +1038,13 @@ void SmileiMPI::recv(Field* field, int from, int hindex)
 } // End recv ( Field )
 
 
+void SmileiMPI::irecv(Field* field, int from, int hindex, MPI_Request& request)
+{
+    MPI_Irecv( &((*field)(0)),field->globalDims_, MPI_DOUBLE, from, hindex, MPI_COMM_WORLD, &request );
+
+} // End irecv ( Field )
+
+
 void SmileiMPI::isend( ProbeParticles* probe, int to, int tag, unsigned int nDim_particles )
 {
     MPI_Request request; 
@@ -9,6 +9,7 @@
 #include "Tools.h"
 #include "Particles.h"
 #include "Field.h"
+#include "NeighborhoodExchange.h"
 
 class Params;
 class Species;
@@ -24,6 +25,9 @@ class DiagnosticScreen;
 
 #define SMILEI_COMM_DUMP_TIME 1312
 
+//! Max number of ghost layers sent per patch and per direction in one exchange through the shared memory window
+#define SMILEI_GHOST_MSGS 3
+
 //  --------------------------------------------------------------------------------------------------------------------
 //! Class SmileiMPI
 //  --------------------------------------------------------------------------------------------------------------------
@@ -32,6 +36,7 @@ class SmileiMPI {
     friend class PatchesFactory;
     friend class Patch;
     friend class VectorPatch;
+    friend class SyncVectorPatch;
 
 public:
     
@@ -52,12 +57,39 @@ public:
     // Initialize the patch_count vector. Patches are distributed in order to balance the load between MPI processes.
     void init_patch_count( Params& params );
     // Recompute the patch_count vector. Browse patches and redistribute them in order to balance the load between MPI processes.
-    void recompute_patch_count( Params& params, VectorPatch& vecpatches, double time_dual );
+    //   - node_only : patches only shifted between the processes of a same node (see SMILEI_COMM_NODE)
+    void recompute_patch_count( Params& params, VectorPatch& vecpatches, double time_dual, bool node_only=false );
+    //! Patches can be balanced inside the nodes : several processes on some nodes, with contiguous ranks on all
+    //! (same answer on all processes)
+    inline bool nodeBalancing() { return node_balancing_; }
      // Returns the rank of the MPI process currently owning patch h.
     int hrank(int h);
     
-    // Create MPI type to exchange all particles properties of particles
-    MPI_Datatype createMPIparticles( Particles* particles );
+    
+    // FIELD GHOST LAYERS THROUGH THE SHARED MEMORY OF THE NODE
+    // --------------------------------------------------------
+    
+    //! Ghost layers exchanged through the shared memory window with the processes of the same node
+    inline bool sharedGhosts() { return shared_ghosts_; }
+    //! Rank in SMILEI_COMM_NODE of the process rank of SMILEI_COMM_WORLD, -1 if it runs on another node
+    inline int nodeRank(int rank) { return world_to_node_[rank]; }
+    //! (Re)allocate the shared memory window according to the current patch_count (collective on the node)
+    void allocateGhostWindow( Params& params );
+    //! Address in the shared memory window of the ghost layers sent by patch h (owned by process rank) in direction iNeighbor
+    char* ghostSlot( int rank, int h, int iDim, int iNeighbor );
+    //! Make the ghost layers written in the window by all processes of the node visible to all
+    void syncGhostWindow();
+    
+    
+    // FIELD GHOST LAYERS THROUGH NEIGHBORHOOD COLLECTIVES
+    // ---------------------------------------------------
+    
+    //! Neighborhood collective used by the patches for the ghost layers, NULL if point-to-point messages
+    inline NeighborhoodExchange* neighborhood() { return neighborhood_; }
+    //! (Re)create the topology communicator from the MPI neighbors of the patches (collective on SMILEI_COMM_WORLD)
+    void createNeighborhood( VectorPatch& vecPatches );
+    //! Print the volume of the ghost layers exchanged through the neighborhood collectives
+    void neighborhoodVolume();
     
     
     // PATCH SEND / RECV METHODS
@@ -67,20 +99,26 @@ public:
     void isend(Patch* patch, int to  , int hindex, Params& params);
     void waitall(Patch* patch);
     void recv (Patch* patch, int from, int hindex, Params& params);
+    //! Post the receptions of a patch, completed by waitRecv
+    void irecv(Patch* patch, int from, int hindex, Params& params);
+    void waitRecv(Patch* patch, int from, int hindex, Params& params);
     
-    void isend(Particles* particles, int to   , int hindex, MPI_Datatype datatype, MPI_Request& request);
-    void recv (Particles* partictles, int from, int hindex, MPI_Datatype datatype);
+    void isend(std::vector<char>* vec, int to  , int hindex, MPI_Request& request);
+    void recv (std::vector<char> *vec, int from, int hindex);
     void isend(std::vector<int>* vec, int to  , int hindex, MPI_Request& request);
     void recv (std::vector<int> *vec, int from, int hindex);
+    void irecv(std::vector<int> *vec, int from, int hindex, MPI_Request& request);
 
     void isend(std::vector<double>* vec, int to  , int hindex, MPI_Request& request);
     void recv (std::vector<double> *vec, int from, int hindex);
+    void irecv(std::vector<double> *vec, int from, int hindex, MPI_Request& request);
 
     void isend(ElectroMagn* fields, int to  , int maxtag, std::vector<MPI_Request>& requests, int mpi_tag);
-    void recv (ElectroMagn* fields, int from, int hindex);
+    void irecv(ElectroMagn* fields, int from, int maxtag, std::vector<MPI_Request>& requests, int mpi_tag);
     void isend(Field* field, int to  , int hindex, MPI_Request& request);
 
     void recv (Field* field, int from, int hindex);
+    void irecv(Field* field, int from, int hindex, MPI_Request& request);
     void isend( ProbeParticles* probe, int to  , int hindex, unsigned int );
     void recv ( ProbeParticles* probe, int from, int hindex, unsigned int );
     
@@ -131,6 +169,8 @@ public:
     std::vector<std::vector<int>> dynamics_iold;
     //! delta_old_pos
     std::vector<std::vector<double>> dynamics_deltaold;
+    //! thread-private current tile (Jx, Jy, Jz, rho of one bin), see Species::dynamicsTiled
+    std::vector<std::vector<double>> dynamics_Jtile;
     
     // Resize buffers for a given number of particles
     inline void dynamics_resize(int ithread, int ndim_part, int npart ){
@@ -141,6 +181,11 @@ public:
         dynamics_deltaold[ithread].resize(ndim_part*npart);
     }
     
+    // Reset the current tile of a thread to size zeros
+    inline void dynamics_resetTile(int ithread, unsigned int size ){
+        dynamics_Jtile[ithread].assign(size, 0.);
+    }
+    
     
     // Compute global number of particles
     //     - deprecated with patch introduction
@@ -155,6 +200,30 @@ public:
 protected:
     //! Global MPI Communicator
     MPI_Comm SMILEI_COMM_WORLD;
+    //! Duplicate of SMILEI_COMM_WORLD for the particles aggregated per MPI process (avoids tag conflicts with patches)
+    MPI_Comm SMILEI_COMM_PARTICLES;
+    //! Processes sharing the memory of a same node
+    MPI_Comm SMILEI_COMM_NODE;
+    //! Number of MPI process in the node, and Id in the node
+    int node_sz, node_rk;
+    //! The ranks of the processes of each node are contiguous, and some nodes run several processes
+    int node_balancing_;
+    //! Rank in SMILEI_COMM_NODE of all processes, -1 for those of other nodes
+    std::vector<int> world_to_node_;
+    
+    //! Field ghost layers exchanged through the shared memory window (see Params::shared_memory_ghosts)
+    bool shared_ghosts_;
+    //! Shared memory window on SMILEI_COMM_NODE, SMILEI_GHOST_MSGS slots per patch and per direction
+    MPI_Win ghost_win_;
+    //! Base address of the segment of each process of the node in the window
+    std::vector<char*> ghost_base_;
+    //! Size in bytes of a slot (largest packed ghost layer)
+    int ghost_slot_bytes_;
+    //! Number of dimensions of the fields
+    int ghost_ndim_;
+    
+    //! Ghost layers exchanged through neighborhood collectives (see Params::neighborhood_collectives)
+    NeighborhoodExchange* neighborhood_;
     
     //! Number of MPI process in the current communicator
     int smilei_sz;
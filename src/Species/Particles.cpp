@@ -1,5 +1,6 @@
 #include "Particles.h"
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -17,15 +18,19 @@ using namespace std;
 // Constructor for Particle
 // ---------------------------------------------------------------------------------------------------------------------
 Particles::Particles():
-tracked(false)
+tracked(false),
+relative_positions(false)
 {
     Position.resize(0);
     Position_old.resize(0);
     Momentum.resize(0);
+    Cell.resize(0);
+    Offset.resize(0);
     isTest = false;
     isRadReaction = false;
 
     double_prop.resize(0);
+    float_prop.resize(0);
     short_prop.resize(0);
     uint64_prop.resize(0);
 }
@@ -54,9 +59,9 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
             double_prop.push_back( &(Position[i]) );
         
         for (unsigned int i=0 ; i< 3 ; i++)
-            double_prop.push_back( &(Momentum[i]) );
+            add_property( Momentum[i] );
         
-        double_prop.push_back( &Weight );
+        add_property( Weight );
         
 #ifdef  __DEBUG
         Position_old.resize(nDim);
@@ -70,7 +75,14 @@ void Particles::initialize(unsigned int nParticles, unsigned int nDim)
         }
         
         if (isRadReaction) {
-            double_prop.push_back( &Chi );
+            add_property( Chi );
+        }
+        
+        if (relative_positions) {
+            for (unsigned int i=0 ; i< nDim ; i++)
+                double_prop.push_back( &(Cell[i]) );
+            for (unsigned int i=0 ; i< nDim ; i++)
+                double_prop.push_back( &(Offset[i]) );
         }
         
     }
@@ -86,6 +98,8 @@ void Particles::initialize(unsigned int nParticles, Particles &part)
     
     isRadReaction=part.isRadReaction;
     
+    relative_positions=part.relative_positions;
+    
     initialize(nParticles, part.Position.size());
 }
 
@@ -119,6 +133,31 @@ void Particles::reserve( unsigned int n_part_max, unsigned int nDim )
 
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Make room for nAdditionalParticles particles at the end of the vectors
+// All properties grow together, geometrically, and their capacity is padded to a multiple of the SIMD width
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::reserve_additional( unsigned int nAdditionalParticles )
+{
+    unsigned int n_needed = size() + nAdditionalParticles;
+    if ( n_needed <= capacity() ) return;
+    
+    unsigned int n_part_max = max( n_needed, 2*capacity() );
+    n_part_max = ( (n_part_max+simd_padding-1)/simd_padding ) * simd_padding;
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        double_prop[iprop]->reserve( n_part_max );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        float_prop[iprop]->reserve( n_part_max );
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        short_prop[iprop]->reserve( n_part_max );
+    
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        uint64_prop[iprop]->reserve( n_part_max );
+}
+
 void Particles::resize( unsigned int nParticles, unsigned int nDim )
 {
     Position.resize(nDim);
@@ -145,19 +184,31 @@ void Particles::resize( unsigned int nParticles, unsigned int nDim )
     if (isRadReaction) {
         Chi.resize(nParticles, 0.);
     }
+    
+    if (relative_positions) {
+        Cell.resize(nDim);
+        Offset.resize(nDim);
+        for (unsigned int i=0 ; i<nDim ; i++) {
+            Cell[i].resize(nParticles, -1.);
+            Offset[i].resize(nParticles, 0.);
+        }
+    }
 }
 
 void Particles::shrink_to_fit( unsigned int nDim )
 {
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
-        std::vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+        aligned_vector<double>( *double_prop[iprop] ).swap( *double_prop[iprop] );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        aligned_vector<float>( *float_prop[iprop] ).swap( *float_prop[iprop] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
-        std::vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
+        aligned_vector<short>( *short_prop[iprop] ).swap( *short_prop[iprop] );
 
     for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) 
-        std::vector<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
+        aligned_vector<uint64_t>( *uint64_prop[iprop] ).swap( *uint64_prop[iprop] );
 }
 
 
@@ -168,6 +219,9 @@ void Particles::clear()
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         double_prop[iprop]->clear();
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        float_prop[iprop]->clear();
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         short_prop[iprop]->clear();
@@ -181,8 +235,13 @@ void Particles::clear()
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particle(unsigned int ipart, Particles &dest_parts )
 {
+    dest_parts.reserve_additional( 1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->push_back( (*double_prop[iprop])[ipart] );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->push_back( (*float_prop[iprop])[ipart] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->push_back( (*short_prop[iprop])[ipart] );
@@ -196,8 +255,13 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particle(unsigned int ipart, Particles &dest_parts, int dest_id )
 {
+    dest_parts.reserve_additional( 1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, (*double_prop[iprop])[ipart] );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, (*float_prop[iprop])[ipart] );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, (*short_prop[iprop])[ipart] );    
@@ -212,8 +276,13 @@ void Particles::cp_particle(unsigned int ipart, Particles &dest_parts, int dest_
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::cp_particles(unsigned int iPart, unsigned int nPart, Particles &dest_parts, int dest_id )
 {
+    dest_parts.reserve_additional( nPart );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         dest_parts.double_prop[iprop]->insert( dest_parts.double_prop[iprop]->begin() + dest_id, double_prop[iprop]->begin()+iPart, double_prop[iprop]->begin()+iPart+nPart );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        dest_parts.float_prop[iprop]->insert( dest_parts.float_prop[iprop]->begin() + dest_id, float_prop[iprop]->begin()+iPart, float_prop[iprop]->begin()+iPart+nPart );
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         dest_parts.short_prop[iprop]->insert( dest_parts.short_prop[iprop]->begin() + dest_id, short_prop[iprop]->begin()+iPart, short_prop[iprop]->begin()+iPart+nPart );
@@ -230,6 +299,9 @@ void Particles::erase_particle(unsigned int ipart )
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart );
@@ -246,6 +318,9 @@ void Particles::erase_particle_trail(unsigned int ipart)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).end() );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart, (*float_prop[iprop]).end() );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).end() );
@@ -261,6 +336,9 @@ void Particles::erase_particle(unsigned int ipart, unsigned int npart)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*double_prop[iprop]).erase( (*double_prop[iprop]).begin()+ipart, (*double_prop[iprop]).begin()+ipart+npart );
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).erase( (*float_prop[iprop]).begin()+ipart, (*float_prop[iprop]).begin()+ipart+npart );
             
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*short_prop[iprop]).erase( (*short_prop[iprop]).begin()+ipart, (*short_prop[iprop]).begin()+ipart+npart );
@@ -270,6 +348,204 @@ void Particles::erase_particle(unsigned int ipart, unsigned int npart)
     
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Suppress the particles listed in indexes (sorted)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::erase_particles( const std::vector<int> &indexes )
+{
+    erase_and_insert( indexes, *this, std::vector<int>(), std::vector<int>() );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Rebuild the property prop from index first, new particle i being taken from prop if origin[i]>=0,
+// and from particle -1-origin[i] of src otherwise
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void rebuild_property( aligned_vector<T> &prop, aligned_vector<T> &src, const std::vector<int> &origin, unsigned int first, aligned_vector<T> &buffer )
+{
+    unsigned int n = origin.size();
+    buffer.resize( n );
+    for ( unsigned int i=0 ; i<n ; i++ )
+        buffer[i] = origin[i]>=0 ? prop[origin[i]] : src[-1-origin[i]];
+    prop.resize( first+n );
+    for ( unsigned int i=0 ; i<n ; i++ )
+        prop[first+i] = buffer[i];
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Suppress the particles listed in indexes (sorted) and insert the particles of source
+// Source particle i goes before particle insert_before[i] (the insert positions refer to the current indexing)
+// Particles sharing the same position are ordered by insert_bins (if not empty), then keep their order in source :
+// an empty bin has the same bound as the previous one, its particles must go after those of the previous bin
+// Particles before the first modified index are not touched, the others are moved once
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::erase_and_insert( const std::vector<int> &indexes, Particles &source, const std::vector<int> &insert_before,
+                                  const std::vector<int> &insert_bins )
+{
+    unsigned int npart   = size();
+    unsigned int nremove = indexes.size();
+    unsigned int ninsert = insert_before.size();
+    if ( nremove==0 && ninsert==0 ) return;
+    
+    // Order in which the source particles are inserted
+    std::vector<int> order(ninsert);
+    for ( unsigned int i=0 ; i<ninsert ; i++ )
+        order[i] = i;
+    if ( insert_bins.empty() )
+        std::stable_sort( order.begin(), order.end(), [&insert_before](int a, int b) {
+            return insert_before[a] < insert_before[b];
+        } );
+    else
+        std::stable_sort( order.begin(), order.end(), [&insert_before, &insert_bins](int a, int b) {
+            return insert_before[a] < insert_before[b]
+                || ( insert_before[a] == insert_before[b] && insert_bins[a] < insert_bins[b] );
+        } );
+    
+    // First index which is modified
+    unsigned int first = npart;
+    if ( nremove>0 ) first = min( first, (unsigned int)indexes[0] );
+    if ( ninsert>0 ) first = min( first, (unsigned int)max( insert_before[order[0]], 0 ) );
+    
+    // Origin of each particle of the new arrays, from index first
+    std::vector<int> origin;
+    origin.reserve( npart + ninsert - first );
+    unsigned int ir = 0, ii = 0;
+    for ( unsigned int ipart=first ; ipart<=npart ; ipart++ ) {
+        while ( ii<ninsert && ( insert_before[order[ii]]<=(int)ipart || ipart==npart ) )
+            origin.push_back( -1-order[ii++] );
+        if ( ipart==npart ) break;
+        if ( ir<nremove && indexes[ir]==(int)ipart ) {
+            while ( ir<nremove && indexes[ir]==(int)ipart ) ir++;
+            continue;
+        }
+        origin.push_back( ipart );
+    }
+    
+    if ( ninsert>nremove )
+        reserve_additional( ninsert-nremove );
+    
+    aligned_vector<double> double_buffer;
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        rebuild_property( *double_prop[iprop], *source.double_prop[iprop], origin, first, double_buffer );
+    
+    aligned_vector<float> float_buffer;
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        rebuild_property( *float_prop[iprop], *source.float_prop[iprop], origin, first, float_buffer );
+    
+    aligned_vector<short> short_buffer;
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        rebuild_property( *short_prop[iprop], *source.short_prop[iprop], origin, first, short_buffer );
+    
+    aligned_vector<uint64_t> uint64_buffer;
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        rebuild_property( *uint64_prop[iprop], *source.uint64_prop[iprop], origin, first, uint64_buffer );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Number of bytes of one particle in a packed buffer
+// ---------------------------------------------------------------------------------------------------------------------
+unsigned int Particles::packedSize() const
+{
+    return double_prop.size()*sizeof(double) + float_prop.size()*sizeof(float)
+         + short_prop.size()*sizeof(short)   + uint64_prop.size()*sizeof(uint64_t);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Append the values of the property prop for the particles listed in indexes to buffer
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void pack_property( const aligned_vector<T> &prop, const std::vector<int> &indexes, std::vector<char> &buffer )
+{
+    size_t pos = buffer.size();
+    buffer.resize( pos + indexes.size()*sizeof(T) );
+    // The buffer is not aligned on sizeof(T) once shorts have been packed
+    for ( unsigned int i=0 ; i<indexes.size() ; i++, pos+=sizeof(T) )
+        memcpy( &buffer[pos], &prop[indexes[i]], sizeof(T) );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Append the particles listed in indexes to buffer, property by property (see unpack)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::pack( std::vector<char> &buffer, const std::vector<int> &indexes ) const
+{
+    buffer.reserve( buffer.size() + indexes.size()*packedSize() );
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        pack_property( *double_prop[iprop], indexes, buffer );
+    
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        pack_property( *float_prop[iprop], indexes, buffer );
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        pack_property( *short_prop[iprop], indexes, buffer );
+    
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        pack_property( *uint64_prop[iprop], indexes, buffer );
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Append particles iPart to iPart+nPart-1 to buffer, property by property (see unpack)
+// ---------------------------------------------------------------------------------------------------------------------
+void Particles::pack( std::vector<char> &buffer, unsigned int iPart, unsigned int nPart ) const
+{
+    if ( nPart==0 ) return;
+    
+    size_t pos = buffer.size();
+    buffer.resize( pos + nPart*packedSize() );
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) {
+        memcpy( &buffer[pos], &(*double_prop[iprop])[iPart], nPart*sizeof(double) );
+        pos += nPart*sizeof(double);
+    }
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy( &buffer[pos], &(*float_prop[iprop])[iPart], nPart*sizeof(float) );
+        pos += nPart*sizeof(float);
+    }
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
+        memcpy( &buffer[pos], &(*short_prop[iprop])[iPart], nPart*sizeof(short) );
+        pos += nPart*sizeof(short);
+    }
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ ) {
+        memcpy( &buffer[pos], &(*uint64_prop[iprop])[iPart], nPart*sizeof(uint64_t) );
+        pos += nPart*sizeof(uint64_t);
+    }
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Replace the values of the property prop by the nPart values read in buffer at position pos
+// ---------------------------------------------------------------------------------------------------------------------
+template<typename T>
+static void unpack_property( aligned_vector<T> &prop, unsigned int nPart, const char* buffer, size_t &pos )
+{
+    prop.resize( nPart );
+    if ( nPart>0 )
+        memcpy( &prop[0], buffer+pos, nPart*sizeof(T) );
+    pos += nPart*sizeof(T);
+}
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Replace the particles by the nPart particles packed in buffer (by pack, from particles with the same properties)
+// Returns the number of bytes read
+// ---------------------------------------------------------------------------------------------------------------------
+size_t Particles::unpack( const char* buffer, unsigned int nPart )
+{
+    size_t pos = 0;
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        unpack_property( *double_prop[iprop], nPart, buffer, pos );
+    
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        unpack_property( *float_prop[iprop], nPart, buffer, pos );
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        unpack_property( *short_prop[iprop], nPart, buffer, pos );
+    
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        unpack_property( *uint64_prop[iprop], nPart, buffer, pos );
+    
+    return pos;
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Print parameters of particle iPart
 // ---------------------------------------------------------------------------------------------------------------------
@@ -325,6 +601,9 @@ void Particles::swap_part(unsigned int part1, unsigned int part2)
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         std::swap( (*double_prop[iprop])[part1], (*double_prop[iprop])[part2] );
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        std::swap( (*float_prop[iprop])[part1], (*float_prop[iprop])[part2] );
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         std::swap( (*short_prop[iprop])[part1], (*short_prop[iprop])[part2] );
 
@@ -339,6 +618,9 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop])[part2] = (*float_prop[iprop])[part1];
     
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
@@ -354,12 +636,16 @@ void Particles::overwrite_part(unsigned int part1, unsigned int part2)
 void Particles::overwrite_part(unsigned int part1, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        memcpy(& (*float_prop[iprop])[part2],  &(*float_prop[iprop])[part1], sizefloat);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
     
@@ -374,6 +660,9 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 {
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ ) 
         (*dest_parts.double_prop[iprop])[part2] = (*double_prop[iprop])[part1];
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*dest_parts.float_prop[iprop])[part2] = (*float_prop[iprop])[part1];
         
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) 
         (*dest_parts.short_prop[iprop])[part2] = (*short_prop[iprop])[part1];
@@ -388,12 +677,16 @@ void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsign
 void Particles::overwrite_part(unsigned int part1, Particles &dest_parts, unsigned int part2, unsigned int N)
 {
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
 
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.double_prop[iprop])[part2],  &(*double_prop[iprop])[part1], sizepart);
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        memcpy(& (*dest_parts.float_prop[iprop])[part2],  &(*float_prop[iprop])[part1], sizefloat);
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         memcpy(& (*dest_parts.short_prop[iprop])[part2] ,  &(*short_prop[iprop])[part1] , sizecharge);
     
@@ -411,6 +704,7 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
     double* buffer[N];
     
     unsigned int sizepart = N*sizeof(Position[0][0]);
+    unsigned int sizefloat = N*sizeof(float);
     unsigned int sizecharge = N*sizeof(Charge[0]);
     unsigned int sizeid = N*sizeof(Id[0]);
     
@@ -420,6 +714,12 @@ void Particles::swap_part(unsigned int part1, unsigned int part2, unsigned int N
         memcpy(&((*double_prop[iprop])[part2]), buffer, sizepart);
     }
 
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ ) {
+        memcpy(buffer,&((*float_prop[iprop])[part1]), sizefloat);
+        memcpy(&((*float_prop[iprop])[part1]), &((*float_prop[iprop])[part2]), sizefloat);
+        memcpy(&((*float_prop[iprop])[part2]), buffer, sizefloat);
+    }
+
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ ) {
         memcpy(buffer,&((*short_prop[iprop])[part1]), sizecharge);
         memcpy(&((*short_prop[iprop])[part1]), &((*short_prop[iprop])[part2]), sizecharge);
@@ -447,19 +747,51 @@ void Particles::push_to_end(unsigned int iPart )
 // ---------------------------------------------------------------------------------------------------------------------
 void Particles::create_particle()
 {
+    reserve_additional( 1 );
+    
     for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
         (*double_prop[iprop]).push_back(0.);
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).push_back(0.);
     
     for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
         (*short_prop[iprop]).push_back(0);
 
     for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
         (*uint64_prop[iprop]).push_back(0);
+    
+    // The relative position of the new particle is not known yet
+    for ( unsigned int i=0 ; i<Cell.size() ; i++ )
+        Cell[i].back() = -1.;
 }
 
 // ---------------------------------------------------------------------------------------------------------------------
 // Create nParticles new particles at the end of vectors
 // ---------------------------------------------------------------------------------------------------------------------
+void Particles::create_particles(unsigned int nAdditionalParticles )
+{
+    reserve_additional( nAdditionalParticles );
+    
+    unsigned int nParticles = size() + nAdditionalParticles;
+    
+    for ( unsigned int iprop=0 ; iprop<double_prop.size() ; iprop++ )
+        (*double_prop[iprop]).resize(nParticles, 0.);
+
+    for ( unsigned int iprop=0 ; iprop<float_prop.size() ; iprop++ )
+        (*float_prop[iprop]).resize(nParticles, 0.);
+    
+    for ( unsigned int iprop=0 ; iprop<short_prop.size() ; iprop++ )
+        (*short_prop[iprop]).resize(nParticles, 0);
+    
+    for ( unsigned int iprop=0 ; iprop<uint64_prop.size() ; iprop++ )
+        (*uint64_prop[iprop]).resize(nParticles, 0);
+    
+    // The relative positions of the new particles are not known yet
+    for ( unsigned int i=0 ; i<Cell.size() ; i++ )
+        std::fill( Cell[i].end()-nAdditionalParticles, Cell[i].end(), -1. );
+}
+
 //void Particles::create_particles(int nAdditionalParticles )
 //{
 //    int nParticles = size();
@@ -8,6 +8,7 @@
 #include <vector>
 
 #include "Tools.h"
+#include "AlignedAllocator.h"
 #include "TimeSelection.h"
 
 class Particle;
@@ -15,6 +16,14 @@ class Particle;
 class Params;
 class Patch;
 
+//! Floating-point type of the particle momentum, weight and chi factor:
+//! single precision when compiled with __MIXED_PRECISION, double precision otherwise.
+//! Positions, fields and currents always remain in double precision.
+#ifdef __MIXED_PRECISION
+typedef float  particle_real;
+#else
+typedef double particle_real;
+#endif
 
 
 //----------------------------------------------------------------------------------------------------------------------
@@ -38,6 +47,9 @@ public:
     //! Set capacity of Particles vectors
     void reserve( unsigned int n_part_max, unsigned int nDim );
     
+    //! Make room for nAdditionalParticles in all Particles vectors at once
+    void reserve_additional( unsigned int nAdditionalParticles );
+    
     //! Resize Particles vectors
     void resize( unsigned int nParticles, unsigned int nDim );
     
@@ -78,6 +90,24 @@ public:
     //! Suppress all particles from iPart to the end of particle array
     void erase_particle_trail(unsigned int iPart );
     
+    //! Suppress the particles listed in indexes (sorted), in a single pass
+    void erase_particles( const std::vector<int> &indexes );
+    
+    //! Suppress the particles listed in indexes (sorted) and insert the particles of source,
+    //! source particle i being inserted before particle insert_before[i], in a single pass per property
+    //! (ties ordered by insert_bins if not empty)
+    void erase_and_insert( const std::vector<int> &indexes, Particles &source, const std::vector<int> &insert_before,
+                           const std::vector<int> &insert_bins );
+    
+    //! Number of bytes of one particle in a packed buffer (all properties)
+    unsigned int packedSize() const;
+    //! Append the particles listed in indexes to buffer, property by property
+    void pack( std::vector<char> &buffer, const std::vector<int> &indexes ) const;
+    //! Append the particles iPart to iPart+nPart-1 to buffer, property by property
+    void pack( std::vector<char> &buffer, unsigned int iPart, unsigned int nPart ) const;
+    //! Replace the particles by the nPart particles packed in buffer, returns the number of bytes read
+    size_t unpack( const char* buffer, unsigned int nPart );
+    
     //! Print parameters of particle iPart
     void print(unsigned int iPart);
     
@@ -133,33 +163,33 @@ public:
     }
     
     //! Method used to get the list of Particle position
-    inline std::vector<double>  position(unsigned int idim) const {
+    inline aligned_vector<double>  position(unsigned int idim) const {
         return Position[idim];
     }
     
     //! Method used to get the Particle momentum
-    inline double  momentum( unsigned int idim, unsigned int ipart ) const {
+    inline particle_real  momentum( unsigned int idim, unsigned int ipart ) const {
         return Momentum[idim][ipart];
     }
     //! Method used to set a new value to the Particle momentum
-    inline double& momentum( unsigned int idim, unsigned int ipart )       {
+    inline particle_real& momentum( unsigned int idim, unsigned int ipart )       {
         return Momentum[idim][ipart];
     }
       //! Method used to get the Particle momentum
-    inline std::vector<double>  momentum( unsigned int idim ) const {
+    inline aligned_vector<particle_real>  momentum( unsigned int idim ) const {
         return Momentum[idim];
     }
     
     //! Method used to get the Particle weight
-    inline double  weight(unsigned int ipart) const {
+    inline particle_real  weight(unsigned int ipart) const {
         return Weight[ipart];
     }
     //! Method used to set a new value to the Particle weight
-    inline double& weight(unsigned int ipart)       {
+    inline particle_real& weight(unsigned int ipart)       {
         return Weight[ipart];
     }
     //! Method used to get the Particle weight
-    inline std::vector<double>  weight() const {
+    inline aligned_vector<particle_real>  weight() const {
         return Weight;
     }
     
@@ -172,39 +202,67 @@ public:
         return Charge[ipart];
     }
     //! Method used to get the list of Particle charges
-    inline std::vector<short>  charge() const {
+    inline aligned_vector<short>  charge() const {
         return Charge;
     }
     
     
+    //! Method used to get the index of the primal node nearest to the Particle (-1 if not computed yet)
+    inline double  cell( unsigned int idim, unsigned int ipart ) const {
+        return Cell[idim][ipart];
+    }
+    //! Method used to get the normalized offset of the Particle relative to its nearest primal node
+    inline double  offset( unsigned int idim, unsigned int ipart ) const {
+        return Offset[idim][ipart];
+    }
+    //! Method used to move the Particle by a whole number of cells (periodic boundaries),
+    //! its nearest primal node moved accordingly when it is known
+    inline void shiftPosition( unsigned int idim, unsigned int ipart, double length, int ncells ) {
+        Position[idim][ipart] += length;
+        if ( relative_positions && ( Cell[idim][ipart] >= 0. ) )
+            Cell[idim][ipart] += ncells;
+    }
+    
     //! Method used to get the Particle Lorentz factor
     inline double lor_fac(unsigned int ipart) {
         return sqrt(1.+pow(momentum(0,ipart),2)+pow(momentum(1,ipart),2)+pow(momentum(2,ipart),2));
     }
     
-    //! Partiles properties, respect type order : all double, all short, all unsigned int
+    //! Partiles properties, respect type order : all double, all float, all short, all unsigned int
+    //! Each property is stored in its own array, aligned on SMILEI_ALIGNMENT bytes
+    //! with a capacity padded to a multiple of the SIMD width
+    
+    //! Number of particles in one SIMD-width of doubles, the capacity is a multiple of it
+    static const unsigned int simd_padding = SMILEI_ALIGNMENT/sizeof(double);
     
     //! array containing the particle position
-    std::vector< std::vector<double> > Position;
+    std::vector< aligned_vector<double> > Position;
     
     //! array containing the particle former (old) positions
-    std::vector< std::vector<double> >Position_old;
+    std::vector< aligned_vector<double> > Position_old;
+    
+    //! array containing the index of the primal node nearest to the particle (stored as a double),
+    //! -1 when it has not been computed since the particle was created
+    std::vector< aligned_vector<double> > Cell;
+    
+    //! array containing the normalized position of the particle relative to its primal node, in [-0.5,0.5]
+    std::vector< aligned_vector<double> > Offset;
     
     //! array containing the particle moments
-    std::vector< std::vector<double> >  Momentum;
+    std::vector< aligned_vector<particle_real> > Momentum;
     
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Weight;
+    aligned_vector<particle_real> Weight;
     
     //! containing the particle weight: equivalent to a charge density
-    std::vector<double> Chi;
+    aligned_vector<particle_real> Chi;
     
     
     //! charge state of the particle (multiples of e>0)
-    std::vector<short> Charge;
+    aligned_vector<short> Charge;
     
     //! Id of the particle
-    std::vector<uint64_t> Id;
+    aligned_vector<uint64_t> Id;
     
     // TEST PARTICLE PARAMETERS
     bool isTest;
@@ -212,6 +270,10 @@ public:
     //! True if tracking the particles (activates one DiagTrack)
     bool tracked;
     
+    //! True if the particles also store their position relative to their nearest primal node
+    //! (updated by the projector, read by the interpolator at the next time step)
+    bool relative_positions;
+    
     void resetIds() {
         unsigned int s = Id.size();
         for (unsigned int iPart=0; iPart<s; iPart++) Id[iPart] = 0;
@@ -227,7 +289,7 @@ public:
         return Id[ipart];
     }
     //! Method used to get the Particle Ids
-    inline std::vector<uint64_t> id() const {
+    inline aligned_vector<uint64_t> id() const {
         return Id;
     }
     void sortById();
@@ -239,21 +301,22 @@ public:
     
     
     //! Method used to get the Particle chi factor
-    inline double  chi(unsigned int ipart) const {
+    inline particle_real  chi(unsigned int ipart) const {
         return Chi[ipart];
     }
     //! Method used to set a new value to the Particle chi factor
-    inline double& chi(unsigned int ipart)       {
+    inline particle_real& chi(unsigned int ipart)       {
         return Chi[ipart];
     }
     //! Method used to get the Particle chi factor
-    inline std::vector<double>  chi() const {
+    inline aligned_vector<particle_real>  chi() const {
         return Chi;
     }
     
-    std::vector< std::vector<double  >*> double_prop;
-    std::vector< std::vector<short   >*> short_prop;
-    std::vector< std::vector<uint64_t>*> uint64_prop;
+    std::vector< aligned_vector<double  >*> double_prop;
+    std::vector< aligned_vector<float   >*> float_prop;
+    std::vector< aligned_vector<short   >*> short_prop;
+    std::vector< aligned_vector<uint64_t>*> uint64_prop;
     
     
     //bool test_move( int iPartStart, int iPartEnd, Params& params );
@@ -275,18 +338,28 @@ public:
     
     Particle operator()(unsigned int iPart);
     
-    //! Methods to obtain the any property, given its index in the arrays double_prop, uint64_prop, or short_prop
-    void getProperty(unsigned int iprop, std::vector<uint64_t>* &prop) {
+    //! Methods to obtain the any property, given its index in the arrays double_prop, float_prop, uint64_prop, or short_prop
+    void getProperty(unsigned int iprop, aligned_vector<uint64_t>* &prop) {
         prop = uint64_prop[iprop];
     }
-    void getProperty(unsigned int iprop, std::vector<short>* &prop) {
+    void getProperty(unsigned int iprop, aligned_vector<short>* &prop) {
         prop = short_prop[iprop];
     }
-    void getProperty(unsigned int iprop, std::vector<double>* &prop) {
+    void getProperty(unsigned int iprop, aligned_vector<double>* &prop) {
         prop = double_prop[iprop];
     }
+    void getProperty(unsigned int iprop, aligned_vector<float>* &prop) {
+        prop = float_prop[iprop];
+    }
     
 private:
+    //! Register a floating-point property in double_prop or float_prop, depending on its type
+    void add_property( aligned_vector<double> &prop ) {
+        double_prop.push_back( &prop );
+    }
+    void add_property( aligned_vector<float> &prop ) {
+        float_prop.push_back( &prop );
+    }
 
 };
 
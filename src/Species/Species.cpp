@@ -45,6 +45,8 @@ using namespace std;
 Species::Species(Params& params, Patch* patch) :
 c_part_max(1),
 dynamics_type("norm"), 
+dynamics_chunk_size(0), 
+cell_sorting(false), 
 time_frozen(0), 
 radiating(false), 
 ionization_model("none"),
@@ -55,6 +57,7 @@ electron_species(NULL),
 electron_species_index(-1),
 clrw(params.clrw),  
 oversize(params.oversize), 
+n_space(params.n_space), 
 cell_length(params.cell_length), 
 min_loc_vec(patch->getDomainLocalMin()), 
 partBoundCond(NULL),
@@ -108,6 +111,11 @@ void Species::initCluster(Params& params)
         b_dim[2] = f_dim2;
     }
     
+    // Tiles hold b_dim[0] rows of each current array, including the dual ones
+    tile_size = b_dim[0];
+    for (unsigned int i=1 ; i<b_dim.size() ; i++)
+        tile_size *= b_dim[i]+1;
+    
     //Initialize specMPI
     MPIbuff.allocate(nDim_particle);
        
@@ -141,15 +149,11 @@ void Species::initOperators(Params& params, Patch* patch)
     for (unsigned int iDim=0 ; iDim < nDim_particle ; iDim++){
         for (unsigned int iNeighbor=0 ; iNeighbor<2 ; iNeighbor++) {
             MPIbuff.partRecv[iDim][iNeighbor].initialize(0, (*particles));
-            MPIbuff.partSend[iDim][iNeighbor].initialize(0, (*particles));
             MPIbuff.part_index_send[iDim][iNeighbor].resize(0);
             MPIbuff.part_index_recv_sz[iDim][iNeighbor] = 0;
             MPIbuff.part_index_send_sz[iDim][iNeighbor] = 0;
         }
     }
-    typePartSend.resize(nDim_particle*2, MPI_DATATYPE_NULL);
-    typePartRecv.resize(nDim_particle*2, MPI_DATATYPE_NULL);
-    exchangePatch = MPI_DATATYPE_NULL;
 
 }
 
@@ -438,7 +442,6 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
     clearExchList();
     
     int tid(0);
-    double ener_iPart(0.);
     std::vector<double> nrj_lost_per_thd(1, 0.);
     
     // -------------------------------
@@ -448,50 +451,9 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
         
         smpi->dynamics_resize(ithread, nDim_particle, bmax.back());
         
-        //Point to local thread dedicated buffers
-        //Still needed for ionization
-        vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
-        
-        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++) {
-            
-            // Interpolate the fields at the particle position
-            (*Interp)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread );
-            
-            //Ionization
-            if (Ionize)
-                (*Ionize)(particles, bmin[ibin], bmax[ibin], Epart, EMfields, Proj);
-            
-            // Push the particles
-            (*Push)(*particles, smpi, bmin[ibin], bmax[ibin], ithread );
-            //particles->test_move( bmin[ibin], bmax[ibin], params );
-            
-            // Apply wall and boundary conditions
-            for(unsigned int iwall=0; iwall<partWalls->size(); iwall++) {
-                for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
-                    double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
-                    if ( !(*partWalls)[iwall]->apply(*particles, iPart, this, dtgf, ener_iPart)) {
-                        nrj_lost_per_thd[tid] += mass * ener_iPart;
-                    }
-                }
-            }
-            // Boundary Condition may be physical or due to domain decomposition
-            // apply returns 0 if iPart is not in the local domain anymore
-            //        if omp, create a list per thread
-            for (iPart=bmin[ibin] ; (int)iPart<bmax[ibin]; iPart++ ) {
-                if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
-                    addPartInExchList( iPart );
-                    //nrj_lost_per_thd[tid] += ener_iPart;
-                    nrj_lost_per_thd[tid] += mass * ener_iPart;
-                }
-             }
-            
-            //START EXCHANGE PARTICLES OF THE CURRENT BIN ?
-            
-             // Project currents if not a Test species and charges as well if a diag is needed. 
-             if (!particles->isTest)
-                 (*Proj)(EMfields, *particles, smpi, bmin[ibin], bmax[ibin], ithread, ibin, clrw, diag_flag, b_dim, ispec );
-            
-        }// ibin
+        for (unsigned int ibin = 0 ; ibin < bmin.size() ; ibin++)
+            dynamicsBin( ibin, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi, ithread,
+                         indexes_of_particles_to_exchange, nrj_lost_per_thd[tid], false );
         
         for (unsigned int ithd=0 ; ithd<nrj_lost_per_thd.size() ; ithd++)
             nrj_bc_lost += nrj_lost_per_thd[tid];
@@ -522,6 +484,170 @@ void Species::dynamics(double time_dual, unsigned int ispec, ElectroMagn* EMfiel
 }//END dynamic
 
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Same as dynamics for the bins ibin_min to ibin_max-1 of a moving species, with the currents of each bin projected
+// in a thread-private tile. Tiles are added to the patch currents under the patch lock, so that several threads
+// may process different bins of the same patch at the same time.
+// The list of particles to exchange must have been cleared before, and has to be sorted after.
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::dynamicsTiled(unsigned int ibin_min, unsigned int ibin_max, unsigned int ispec, ElectroMagn* EMfields, Interpolator* Interp,
+                            Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi)
+{
+    int ithread;
+    #ifdef _OPENMP
+        ithread = omp_get_thread_num();
+    #else
+        ithread = 0;
+    #endif
+    
+    vector<int> exchange_list;
+    double nrj_lost(0.);
+    
+    smpi->dynamics_resize(ithread, nDim_particle, bmax.back());
+    
+    // Currents (and density if diag) of the species, where the tiles are added
+    vector<Field*> J(3+diag_flag);
+    J[0] = diag_flag && EMfields->Jx_s[ispec] ? EMfields->Jx_s[ispec] : EMfields->Jx_;
+    J[1] = diag_flag && EMfields->Jy_s[ispec] ? EMfields->Jy_s[ispec] : EMfields->Jy_;
+    J[2] = diag_flag && EMfields->Jz_s[ispec] ? EMfields->Jz_s[ispec] : EMfields->Jz_;
+    if (diag_flag)
+        J[3] = EMfields->rho_s[ispec] ? EMfields->rho_s[ispec] : EMfields->rho_;
+    
+    for (unsigned int ibin = ibin_min ; ibin < ibin_max ; ibin++) {
+        
+        smpi->dynamics_resetTile(ithread, 4*tile_size);
+        
+        dynamicsBin( ibin, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi, ithread,
+                     exchange_list, nrj_lost, true );
+        
+        if (particles->isTest) continue;
+        
+        // Add the tile to the currents of the patch
+        double* b_J = &(smpi->dynamics_Jtile[ithread][0]);
+        EMfields->lockCurrents();
+        for (unsigned int icomp=0 ; icomp<J.size() ; icomp++) {
+            // A tile starts at the first row of the bin, and has the same row size as the field
+            unsigned int row_size = J[icomp]->globalDims_ / J[icomp]->dims_[0];
+            unsigned int start    = ibin*clrw*row_size;
+            unsigned int n        = min( b_dim[0]*row_size, J[icomp]->globalDims_-start );
+            double* field = &(J[icomp]->data_[start]);
+            double* tile  = b_J + icomp*tile_size;
+            #pragma omp simd
+            for (unsigned int i=0 ; i<n ; i++)
+                field[i] += tile[i];
+        }
+        EMfields->unlockCurrents();
+    }
+    
+    EMfields->lockCurrents();
+    indexes_of_particles_to_exchange.insert( indexes_of_particles_to_exchange.end(), exchange_list.begin(), exchange_list.end() );
+    nrj_bc_lost += nrj_lost;
+    EMfields->unlockCurrents();
+    
+}//END dynamicsTiled
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Same as dynamics for the bin ibin of a moving species, run as an OpenMP task by any thread.
+// Bins are coloured by the caller so that concurrent tasks never project on the same rows of the currents.
+// The list of particles to exchange must have been cleared before, and has to be sorted after.
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::dynamicsBinTask(unsigned int ibin, unsigned int ispec, ElectroMagn* EMfields, Interpolator* Interp,
+                              Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi)
+{
+    int ithread;
+    #ifdef _OPENMP
+        ithread = omp_get_thread_num();
+    #else
+        ithread = 0;
+    #endif
+    
+    vector<int> exchange_list;
+    double nrj_lost(0.);
+    
+    smpi->dynamics_resize(ithread, nDim_particle, bmax.back());
+    
+    dynamicsBin( ibin, ispec, EMfields, Interp, Proj, params, diag_flag, partWalls, smpi, ithread,
+                 exchange_list, nrj_lost, false );
+    
+    EMfields->lockCurrents();
+    indexes_of_particles_to_exchange.insert( indexes_of_particles_to_exchange.end(), exchange_list.begin(), exchange_list.end() );
+    nrj_bc_lost += nrj_lost;
+    EMfields->unlockCurrents();
+    
+}//END dynamicsBinTask
+
+
+// ---------------------------------------------------------------------------------------------------------------------
+// Dynamics of the particles of the bin ibin
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::dynamicsBin(unsigned int ibin, unsigned int ispec, ElectroMagn* EMfields, Interpolator* Interp,
+                          Projector* Proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi, int ithread,
+                          vector<int>& exchange_list, double& nrj_lost, bool tiled)
+{
+    unsigned int iPart;
+    double ener_iPart(0.);
+    
+    //Point to local thread dedicated buffers
+    //Still needed for ionization
+    vector<LocalFields> *Epart = &(smpi->dynamics_Epart[ithread]);
+    
+    // Thread-private tile, each current component is stored after the other
+    double* b_J = tiled ? &(smpi->dynamics_Jtile[ithread][0]) : NULL;
+    
+    // Particles of the bin are processed by chunks: each chunk goes through interpolation, push, BC
+    // and projection before the next one is started, so that the staging buffers stay in cache.
+    // A chunk size of 0 means that the whole bin is treated as a single chunk.
+    int chunk_size = dynamics_chunk_size>0 ? dynamics_chunk_size : bmax[ibin]-bmin[ibin];
+    
+    for (int istart=bmin[ibin] ; istart<bmax[ibin] ; istart+=chunk_size ) {
+        int iend = min( istart+chunk_size, bmax[ibin] );
+        
+        // Interpolate the fields at the particle position
+        (*Interp)(EMfields, *particles, smpi, istart, iend, ithread );
+        
+        //Ionization
+        if (Ionize)
+            (*Ionize)(particles, istart, iend, Epart, EMfields, Proj);
+        
+        // Push the particles
+        (*Push)(*particles, smpi, istart, iend, ithread );
+        //particles->test_move( istart, iend, params );
+        
+        // Apply wall and boundary conditions
+        for(unsigned int iwall=0; iwall<partWalls->size(); iwall++) {
+            for (iPart=istart ; (int)iPart<iend; iPart++ ) {
+                double dtgf = params.timestep * smpi->dynamics_invgf[ithread][iPart];
+                if ( !(*partWalls)[iwall]->apply(*particles, iPart, this, dtgf, ener_iPart)) {
+                    nrj_lost += mass * ener_iPart;
+                }
+            }
+        }
+        // Boundary Condition may be physical or due to domain decomposition
+        // apply returns 0 if iPart is not in the local domain anymore
+        //        if omp, create a list per thread
+        for (iPart=istart ; (int)iPart<iend; iPart++ ) {
+            if ( !partBoundCond->apply( *particles, iPart, this, ener_iPart ) ) {
+                exchange_list.push_back( iPart );
+                //nrj_lost += ener_iPart;
+                nrj_lost += mass * ener_iPart;
+            }
+        }
+        
+        
+        // Project currents if not a Test species and charges as well if a diag is needed. 
+        if (!particles->isTest) {
+            if (tiled)
+                (*Proj)(b_J, b_J+tile_size, b_J+2*tile_size, diag_flag ? b_J+3*tile_size : NULL,
+                        *particles, smpi, istart, iend, ithread, ibin, clrw, b_dim );
+            else
+                (*Proj)(EMfields, *particles, smpi, istart, iend, ithread, ibin, clrw, diag_flag, b_dim, ispec );
+        }
+        
+    }// chunk
+}
+
+
 // ---------------------------------------------------------------------------------------------------------------------
 // For all particles of the species
 //   - increment the charge (projection)
@@ -613,6 +739,74 @@ void Species::sort_part()
     }
 }
 
+// ---------------------------------------------------------------------------------------------------------------------
+// Sort particles by cell
+// Particles already located in the index range of their cell are not moved,
+// the others are swapped directly to a free slot of their cell range.
+// ---------------------------------------------------------------------------------------------------------------------
+void Species::cell_sort_part()
+{
+    unsigned int npart = particles->size();
+    
+    double inv_cell[3] = { dx_inv_, dy_inv_, dz_inv_ };
+    int n_cell[3] = { (int)(bmin.size()*clrw), 1, 1 };
+    for (unsigned int idim=1 ; idim<nDim_particle ; idim++)
+        n_cell[idim] = n_space[idim];
+    unsigned int ncells = n_cell[0]*n_cell[1]*n_cell[2];
+    
+    // Cell index of each particle
+    cell_index.resize(npart);
+    for (unsigned int ip=0 ; ip<npart ; ip++) {
+        unsigned int icell = 0;
+        for (unsigned int idim=0 ; idim<nDim_particle ; idim++) {
+            int ix = floor( (particles->position(idim,ip)-min_loc_vec[idim]) * inv_cell[idim] );
+            // particles on the upper border belong to the last cell
+            ix = min( max(ix, 0), n_cell[idim]-1 );
+            icell = icell*n_cell[idim] + ix;
+        }
+        cell_index[ip] = icell;
+    }
+    
+    // Count the particles per cell, then compute the range of each cell
+    first_index.resize(ncells);
+    last_index.assign(ncells, 0);
+    for (unsigned int ip=0 ; ip<npart ; ip++)
+        last_index[cell_index[ip]]++;
+    int tot = 0;
+    for (unsigned int icell=0 ; icell<ncells ; icell++) {
+        first_index[icell] = tot;
+        tot += last_index[icell];
+        last_index[icell] = tot;
+    }
+    
+    // Place the particles which are not in the range of their cell
+    // next[icell] : first slot of icell not yet known to hold a particle of icell
+    vector<int> next(first_index);
+    for (unsigned int icell=0 ; icell<ncells ; icell++) {
+        while (next[icell] < last_index[icell]) {
+            int ip = next[icell];
+            unsigned int jcell = cell_index[ip];
+            if (jcell == icell) {
+                next[icell]++;
+                continue;
+            }
+            while ( cell_index[next[jcell]] == jcell )
+                next[jcell]++;
+            particles->swap_part(ip, next[jcell]);
+            cell_index[ip] = cell_index[next[jcell]];
+            cell_index[next[jcell]] = jcell;
+            next[jcell]++;
+        }
+    }
+    
+    // Bins are made of clrw consecutive cells along x
+    unsigned int cells_per_bin = clrw*n_cell[1]*n_cell[2];
+    for (unsigned int bin=0 ; bin<bmin.size() ; bin++) {
+        bmin[bin] = first_index[ bin   *cells_per_bin  ];
+        bmax[bin] = last_index [(bin+1)*cells_per_bin-1];
+    }
+}
+
 // ---------------------------------------------------------------------------------------------------------------------
 // Sort particles
 // ---------------------------------------------------------------------------------------------------------------------
@@ -877,25 +1071,33 @@ int Species::createParticles(vector<unsigned int> n_space_to_create, Params& par
 // Move all particles from another species to this one
 void Species::importParticles( Params& params, Patch* patch, Particles& source_particles, vector<Diagnostic*>& localDiags )
 {
-    unsigned int npart = source_particles.size(), ibin, ii, nbin=bmin.size();
+    unsigned int npart = source_particles.size(), ibin, nbin=bmin.size();
     double inv_cell_length = 1./ params.cell_length[0];
     
     // If this species is tracked, set the particle IDs
     if( particles->tracked )
         dynamic_cast<DiagnosticTrack*>(localDiags[tracking_diagnostic])->setIDs( source_particles );
     
-    // Move particles
+    // Each particle goes at the end of its bin
+    vector<int> insert_before(npart), import_bins(npart);
+    vector<int> nimport_per_bin(nbin, 0);
     for( unsigned int i=0; i<npart; i++ ) {
-        // Copy particle to the correct bin
         ibin = source_particles.position(0,i)*inv_cell_length - ( patch->getCellStartingGlobalIndex(0) + params.oversize[0] );
         ibin /= params.clrw;
-        source_particles.cp_particle(i, *particles, bmin[ibin] );
-        // Update the bin counts
-        bmax[ibin]++;
-        for (ii=ibin+1; ii<nbin; ii++) {
-            bmin[ii]++;
-            bmax[ii]++;
-        }
+        insert_before[i] = bmax[ibin];
+        import_bins[i] = ibin;
+        nimport_per_bin[ibin]++;
+    }
+    
+    // Move particles, all at once
+    particles->erase_and_insert( vector<int>(), source_particles, insert_before, import_bins );
+    
+    // Update the bin counts
+    int shift = 0;
+    for (ibin=0; ibin<nbin; ibin++) {
+        bmin[ibin] += shift;
+        shift += nimport_per_bin[ibin];
+        bmax[ibin] += shift;
     }
     
     source_particles.clear();
@@ -76,6 +76,12 @@ public:
     //! dynamics type. Possible values: "Norm" "Radiation Reaction"
     std::string dynamics_type;
     
+    //! Number of particles sent together through interpolation, push and projection (0 = whole bin)
+    int dynamics_chunk_size;
+    
+    //! If true, particles are kept sorted by cell instead of by bin
+    bool cell_sorting;
+    
     //! Time for which the species is frozen
     double time_frozen;
     
@@ -135,6 +141,25 @@ public:
                           Projector* proj, Params &params, bool diag_flag,
                           PartWalls* partWalls, Patch* patch, SmileiMPI* smpi, std::vector<Diagnostic*>& localDiags);
     
+    //! Method calculating the Particle dynamics of the bins ibin_min to ibin_max-1 (see tiled_currents):
+    //! the currents of each bin are projected in a thread-private tile, then added to the patch currents.
+    //! Several threads may process different bins of the same patch at the same time.
+    void dynamicsTiled(unsigned int ibin_min, unsigned int ibin_max, unsigned int ispec, ElectroMagn* EMfields, Interpolator* interp,
+                       Projector* proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi);
+    
+    //! Method calculating the Particle dynamics of the bin ibin, run as an OpenMP task (see heavy_patch_factor):
+    //! the currents are projected directly in the patch currents, the caller must ensure that no other task
+    //! projects on the same rows at the same time.
+    void dynamicsBinTask(unsigned int ibin, unsigned int ispec, ElectroMagn* EMfields, Interpolator* interp,
+                         Projector* proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi);
+    
+    //! Method calculating the Particle dynamics of the bin ibin (interpolation, ionization, pusher, boundary conditions, projection)
+    //! Particles leaving the domain are added to exchange_list, and the energy they carry to nrj_lost.
+    //! If tiled, the currents are projected in the thread-private tile of smpi.
+    void dynamicsBin(unsigned int ibin, unsigned int ispec, ElectroMagn* EMfields, Interpolator* interp,
+                     Projector* proj, Params &params, bool diag_flag, PartWalls* partWalls, SmileiMPI* smpi, int ithread,
+                     std::vector<int>& exchange_list, double& nrj_lost, bool tiled);
+    
     //! Method calculating the Particle charge on the grid (projection)
     virtual void computeCharge(unsigned int ispec, ElectroMagn* EMfields, Projector* Proj);
     
@@ -156,6 +181,8 @@ public:
     //! Method used to sort particles
     void sort_part();
     void count_sort_part(Params& param);
+    //! Method used to sort particles by cell, only moving the particles which changed cell
+    void cell_sort_part();
     
     //void updateMvWinLimits(double x_moved);
     
@@ -178,17 +205,21 @@ public:
     unsigned int clrw; //Should divide the number of cells in X of a single MPI domain. 
     //! first and last index of each particle bin
     std::vector<int> bmin, bmax;
+    //! first and last index of each cell (only when cell_sorting)
+    std::vector<int> first_index, last_index;
+    //! cell index of each particle, buffer used by cell_sort_part
+    std::vector<unsigned int> cell_index;
     //! sub dimensions of buffers for dim > 1
     std::vector<unsigned int> b_dim;
     
+    //! Size of each component of the thread-private current tiles, which hold b_dim[0] rows of the current arrays
+    unsigned int tile_size;
+    
     //! Oversize (copy from Params)
     std::vector<unsigned int> oversize;
+    //! Number of cells of the patch (copy from Params)
+    std::vector<unsigned int> n_space;
     
-    //! MPI structure to exchange particles
-    std::vector<MPI_Datatype> typePartSend ;
-    std::vector<MPI_Datatype> typePartRecv ;
-    MPI_Datatype exchangePatch;
-
     //! Cell_length (copy from Params)
     std::vector<double> cell_length;
     //! min_loc_vec (copy from picparams)
@@ -238,6 +269,7 @@ public:
         //speciesSize *= getNbrOfParticles();
         int speciesSize(0);
         speciesSize += particles->double_prop.size()*sizeof(double);
+        speciesSize += particles->float_prop.size()*sizeof(float);
         speciesSize += particles->short_prop.size()*sizeof(short);
         speciesSize += particles->uint64_prop.size()*sizeof(uint64_t);
         speciesSize *= getParticlesCapacity();
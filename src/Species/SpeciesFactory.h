@@ -87,6 +87,19 @@ public:
             ERROR("For species '" << species_type << "' mass not defined.");
         }
         
+        PyTools::extract("dynamics_chunk_size",thisSpecies->dynamics_chunk_size ,"Species",ispec);
+        if (thisSpecies->dynamics_chunk_size < 0) {
+            ERROR("For species '" << species_type << "' dynamics_chunk_size must be positive or zero");
+        }
+        
+        PyTools::extract("cell_sorting",thisSpecies->cell_sorting ,"Species",ispec);
+        
+        PyTools::extract("relative_positions",thisSpecies->particles->relative_positions ,"Species",ispec);
+        if (thisSpecies->particles->relative_positions
+            && ( (params.geometry!="2d3v" && params.geometry!="3d3v") || params.interpolation_order!=2 ) ) {
+            ERROR("For species '" << species_type << "' relative_positions is only available in 2d3v and 3d3v at order 2");
+        }
+        
         PyTools::extract("time_frozen",thisSpecies->time_frozen ,"Species",ispec);
         if (thisSpecies->time_frozen > 0 && thisSpecies->initMomentum_type!="cold") {
             if ( patch->isMaster() ) WARNING("For species '" << species_type << "' possible conflict between time-frozen & not cold initialization");
@@ -289,6 +302,8 @@ public:
         // Copy members
         newSpecies->species_type          = species->species_type;
         newSpecies->dynamics_type         = species->dynamics_type;
+        newSpecies->dynamics_chunk_size   = species->dynamics_chunk_size;
+        newSpecies->cell_sorting          = species->cell_sorting;
         newSpecies->speciesNumber         = species->speciesNumber;
         newSpecies->initPosition_type     = species->initPosition_type;
         newSpecies->initMomentum_type     = species->initMomentum_type;
@@ -325,6 +340,7 @@ public:
         
         newSpecies->particles->isTest              = species->particles->isTest;
         newSpecies->particles->tracked             = species->particles->tracked;
+        newSpecies->particles->relative_positions  = species->particles->relative_positions;
         
         // \todo : NOT SURE HOW THIS BEHAVES WITH RESTART
         if ( (!params.restart) && (with_particles) ) {
@@ -368,6 +384,7 @@ public:
                     retSpecies[ispec1]->electron_species_index = ispec2;
                     retSpecies[ispec1]->electron_species = retSpecies[ispec2];
                     retSpecies[ispec1]->Ionize->new_electrons.tracked = retSpecies[ispec1]->electron_species->particles->tracked;
+                    retSpecies[ispec1]->Ionize->new_electrons.relative_positions = retSpecies[ispec1]->electron_species->particles->relative_positions;
                     retSpecies[ispec1]->Ionize->new_electrons.initialize(0, params.nDim_particle );
                     if ( ( !retSpecies[ispec1]->getNbrOfParticles() ) && ( !retSpecies[ispec2]->getNbrOfParticles() ) ) {
                         int max_eon_number = retSpecies[ispec1]->getNbrOfParticles() * retSpecies[ispec1]->atomic_number;
@@ -400,6 +417,7 @@ public:
                 retSpecies[i]->electron_species_index = vecSpecies[i]->electron_species_index;
                 retSpecies[i]->electron_species = retSpecies[retSpecies[i]->electron_species_index];
                 retSpecies[i]->Ionize->new_electrons.tracked = retSpecies[i]->electron_species->particles->tracked;
+                retSpecies[i]->Ionize->new_electrons.relative_positions = retSpecies[i]->electron_species->particles->relative_positions;
                 retSpecies[i]->Ionize->new_electrons.initialize(0, params.nDim_particle );
             }
         }
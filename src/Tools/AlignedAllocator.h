@@ -0,0 +1,52 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+//! Alignment in bytes of the particle arrays (one cache line, one AVX-512 register)
+#define SMILEI_ALIGNMENT 64
+
+//  --------------------------------------------------------------------------------------------------------------------
+//! Allocator returning memory aligned on Alignment bytes, to be used with std::vector
+//  --------------------------------------------------------------------------------------------------------------------
+template<typename T, std::size_t Alignment = SMILEI_ALIGNMENT>
+class AlignedAllocator {
+public:
+    typedef T value_type;
+
+    template<typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+
+    AlignedAllocator() {}
+    template<typename U>
+    AlignedAllocator( const AlignedAllocator<U, Alignment>& ) {}
+
+    T* allocate( std::size_t n ) {
+        if ( n == 0 ) return NULL;
+        void* p = NULL;
+        if ( posix_memalign( &p, Alignment, n*sizeof(T) ) != 0 )
+            throw std::bad_alloc();
+        return static_cast<T*>( p );
+    }
+
+    void deallocate( T* p, std::size_t ) {
+        free( p );
+    }
+};
+
+template<typename T, typename U, std::size_t Alignment>
+inline bool operator==( const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>& ) { return true; }
+
+template<typename T, typename U, std::size_t Alignment>
+inline bool operator!=( const AlignedAllocator<T, Alignment>&, const AlignedAllocator<U, Alignment>& ) { return false; }
+
+//! std::vector whose data is aligned on SMILEI_ALIGNMENT bytes
+template<typename T>
+using aligned_vector = std::vector<T, AlignedAllocator<T> >;
+
+#endif
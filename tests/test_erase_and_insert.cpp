@@ -0,0 +1,116 @@
+// ---------------------------------------------------------------------------------------------------------------------
+// Particles::erase_and_insert, as used by Patch::insertReceivedParticles : particles received in an empty bin, next
+// to non-empty bins, must be inserted after the particles of the previous bin, whatever their order of reception
+// ---------------------------------------------------------------------------------------------------------------------
+#include <iostream>
+#include <vector>
+
+#include "Particles.h"
+
+using namespace std;
+
+static int nfailures = 0;
+
+#define CHECK( condition ) \
+    if ( !(condition) ) { \
+        cerr << __FILE__ << ":" << __LINE__ << " failed : " << #condition << endl; \
+        nfailures++; \
+    }
+
+// The position of a particle is its bin
+static void fill( Particles &particles, const vector<int> &bins )
+{
+    particles.initialize( bins.size(), 1 );
+    for ( unsigned int i=0 ; i<bins.size() ; i++ ) {
+        particles.position(0,i) = bins[i];
+        particles.weight(i) = i;
+    }
+}
+
+// Each particle in [bmin,bmax[ of its bin
+static bool binned( Particles &particles, const vector<int> &bmin, const vector<int> &bmax )
+{
+    if ( (unsigned int)bmax.back() != particles.size() )
+        return false;
+    for ( unsigned int ibin=0 ; ibin<bmin.size() ; ibin++ )
+        for ( int i=bmin[ibin] ; i<bmax[ibin] ; i++ )
+            if ( particles.position(0,i) != ibin )
+                return false;
+    return true;
+}
+
+// Same steps as Patch::insertReceivedParticles
+static void insert( Particles &particles, vector<int> &bmin, vector<int> &bmax, const vector<int> &sent,
+                    const vector<int> &recv_bins, bool order_by_bin )
+{
+    unsigned int nbin = bmax.size();
+    Particles recv;
+    fill( recv, recv_bins );
+    
+    vector<int> insert_before( recv_bins.size() ), nrecv_per_bin( nbin, 0 );
+    for ( unsigned int j=0 ; j<recv_bins.size() ; j++ ) {
+        insert_before[j] = bmax[recv_bins[j]];
+        nrecv_per_bin[recv_bins[j]]++;
+    }
+    vector<int> nsent_per_bin( nbin, 0 );
+    unsigned int ibin = 0;
+    for ( unsigned int k=0 ; k<sent.size() ; k++ ) {
+        while ( ibin < nbin-1 && sent[k] >= bmax[ibin] ) ibin++;
+        nsent_per_bin[ibin]++;
+    }
+    
+    particles.erase_and_insert( sent, recv, insert_before, order_by_bin ? recv_bins : vector<int>() );
+    
+    for ( ibin=0 ; ibin<nbin ; ibin++ ) {
+        int n = bmax[ibin] - bmin[ibin] - nsent_per_bin[ibin] + nrecv_per_bin[ibin];
+        if ( ibin>0 ) bmin[ibin] = bmax[ibin-1];
+        bmax[ibin] = bmin[ibin] + n;
+    }
+}
+
+int main()
+{
+    // Bins 0 and 2 hold particles, bins 1 and 3 are empty
+    vector<int> bins = { 0, 0, 0, 2, 2 };
+    vector<int> bmin = { 0, 3, 3, 5 };
+    vector<int> bmax = { 3, 3, 5, 5 };
+    
+    // Received for the empty bins before those for the previous bins, one particle of bin 0 sent
+    {
+        Particles particles;
+        fill( particles, bins );
+        vector<int> b0 = bmin, b1 = bmax;
+        insert( particles, b0, b1, vector<int>( 1, 1 ), { 1, 3, 0, 2, 1 }, true );
+        CHECK( particles.size() == 9 );
+        CHECK( b1[0] == 3 && b1[1] == 5 && b1[2] == 8 && b1[3] == 9 );
+        CHECK( binned( particles, b0, b1 ) );
+        // Particles not sent keep their order
+        CHECK( particles.weight(0) == 0 && particles.weight(1) == 2 );
+    }
+    
+    // Only empty bins receive
+    {
+        Particles particles;
+        fill( particles, bins );
+        vector<int> b0 = bmin, b1 = bmax;
+        insert( particles, b0, b1, vector<int>(), { 3, 1, 3 }, true );
+        CHECK( particles.size() == 8 );
+        CHECK( binned( particles, b0, b1 ) );
+    }
+    
+    // Without the bins, the particles received for bin 1 may be inserted among those of bin 0
+    {
+        Particles particles;
+        fill( particles, bins );
+        vector<int> b0 = bmin, b1 = bmax;
+        insert( particles, b0, b1, vector<int>(), { 1, 0 }, false );
+        CHECK( !binned( particles, b0, b1 ) );
+    }
+    
+    if ( nfailures > 0 ) {
+        cerr << nfailures << " failure(s)" << endl;
+        return 1;
+    }
+    cout << "erase_and_insert : OK" << endl;
+    return 0;
+}
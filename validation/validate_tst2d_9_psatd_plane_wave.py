@@ -0,0 +1,38 @@
+import os, re, numpy as np, math, h5py
+from Smilei import *
+
+S = Smilei(".", verbose=False)
+
+# Plane wave of the namelist
+Lsim = S.namelist.Main.sim_length
+kx = 2.*math.pi*5./Lsim[0]
+ky = 2.*math.pi*3./Lsim[1]
+k  = math.sqrt(kx**2+ky**2)
+
+with h5py.File("Fields0.h5") as f:
+	dt = f["data/0000000000"].attrs["dt"]
+	dx = f["data/0000000000/Ez"].attrs["gridSpacing"]
+	patchSize = f["data/0000000000"].attrs["patchSize"]
+
+# ERROR OF THE LAST Ez WITH RESPECT TO THE EXACT PLANE WAVE
+timesteps = list(S.Field.Field0().getAvailableTimesteps())
+Ez = S.Field.Field0.Ez(timesteps=timesteps[-1]).getData()[0]
+t = timesteps[-1]*dt
+x = dx[0]*np.arange(Ez.shape[0])
+y = dx[1]*np.arange(Ez.shape[1])
+error = np.abs( Ez - np.cos( kx*x[:,None] + ky*y[None,:] - k*t ) )
+
+# Points at 2 cells or less from the border of a patch, where the periodic transforms of the patches would show
+ix = np.arange(Ez.shape[0]) % patchSize[0]
+iy = np.arange(Ez.shape[1]) % patchSize[1]
+near_x = np.minimum(ix, patchSize[0]-ix) <= 2
+near_y = np.minimum(iy, patchSize[1]-iy) <= 2
+borders = near_x[:,None] | near_y[None,:]
+
+Validate("Ez error at the patch borders is below 1e-4", np.max(error[borders])<1e-4 )
+Validate("Ez error inside the patches is below 1e-4", np.max(error[~borders])<1e-4 )
+
+# TEST THE GRID PARAMETERS
+Validate("Value of the timestep" , dt, 1e-6)
+Validate("Value of the grid step", dx, 1e-6)
+Validate("Patch size", patchSize)